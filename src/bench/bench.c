@@ -0,0 +1,953 @@
+/*
+ * bench.c
+ *
+ * Created: 10/16/2026
+ */
+
+/*
+ * Linux/POSIX microbenchmarks, the baseline for judging optimisations of the parser, CRC,
+ * serializers and ring buffers. Built by the Bench target of packet.cbp, or by hand
+ *
+ * gcc -O2 -DMAX_PAYLOAD_LEN_BYTES=255 -Isrc src/bench/bench.c src/packet.c src/pckt_crc.c
+ *     src/ring_buffer/ring_buffer.c src/ring_buffer/spsc_ring_buffer.c -o packet_bench
+ *
+ * Each benchmark is sized so one repetition takes about BENCH_REP_NS, run BENCH_WARMUP times
+ * untimed and BENCH_REPS times timed. Reported is time per operation of the repetitions, min,
+ * median, 90th percentile and max, and the rate at the median. Run on an idle machine, pinned
+ * to one core (taskset -c 2 ./packet_bench) for steadier numbers.
+ */
+
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../packet.h"
+#include "../pckt_crc.h"
+#include "../pckt_sr.h"
+#include "../ring_buffer/ring_buffer.h"
+#include "../ring_buffer/spsc_ring_buffer.h"
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#define BENCH_WARMUP      3       //untimed repetitions before measuring
+#define BENCH_REPS        31      //timed repetitions
+#define BENCH_REP_NS      2000000 //target time of one repetition
+#define BENCH_FRAMES      256     //frames in a pckt_task() stream
+#define BENCH_SR_VALUES   256     //values per serializer pass
+#define BENCH_RB_SIZE     256     //ring buffer size
+#define BENCH_CRC_OFFSETS 8       //start offsets the CRC self check runs at, covers every alignment of 8 bytes
+#define BENCH_BATCH_LEN   8       //payload of a batched packet
+#define BENCH_BATCH_SIZE  256     //tx_batch_size and tx_batch_threshold
+#define BENCH_ARRAY_LEN   (MAX_PAYLOAD_LEN_BYTES / sizeof(uint32_t)) //values per array packet
+
+/*Benchmark body, runs iters passes over ctx*/
+typedef void (*bench_fptr_t)(void * const ctx, const uint32_t iters);
+
+/*pckt_task() stream*/
+typedef struct bench_rx_t
+{
+	pckt_inst_t pckt_inst;
+	uint8_t rx_buffer[RX_EXT_BUFFER_LEN_BYTES];
+	uint8_t stream[BENCH_FRAMES * RX_BUFFER_LEN_BYTES];
+	uint32_t stream_len;
+	uint32_t stream_pos;
+} bench_rx_t;
+
+/*pckt_tx_raw()*/
+typedef struct bench_tx_t
+{
+	pckt_inst_t pckt_inst;
+	uint8_t payload[UINT8_MAX];
+	uint8_t len;
+} bench_tx_t;
+
+/*Batched pckt_tx_raw()*/
+typedef struct bench_batch_t
+{
+	pckt_inst_t pckt_inst;
+	uint8_t batch_buffer[BENCH_BATCH_SIZE];
+	uint8_t payload[BENCH_BATCH_LEN];
+} bench_batch_t;
+
+/*CRC engine under self check*/
+typedef struct bench_crc_engine_t
+{
+	const char *name;
+	crc_t (*crc_16_fptr)(const uint8_t * const, uint8_t);
+	crc_t (*crc_16_update_fptr)(crc_t, const uint8_t *, uint16_t);
+} bench_crc_engine_t;
+
+/*CRC-32C engine under self check*/
+typedef struct bench_crc32_engine_t
+{
+	const char *name;
+	uint32_t (*crc_32_update_fptr)(uint32_t, const uint8_t *, uint16_t);
+} bench_crc32_engine_t;
+
+/*uint32 array and its big endian bytes*/
+typedef struct bench_array_t
+{
+	uint32_t values[BENCH_ARRAY_LEN];
+	uint8_t bytes[BENCH_ARRAY_LEN * sizeof(uint32_t)];
+} bench_array_t;
+
+/*CRC engine*/
+typedef struct bench_crc_t
+{
+	crc_t (*crc_16_fptr)(const uint8_t * const, uint8_t);
+	uint8_t data[UINT8_MAX];
+} bench_crc_t;
+
+
+/**************************************************************************************************
+*                                            VARIABLES
+*************************************************^************************************************/
+static volatile TICK_TYPE bench_tick_ms = 0;
+const volatile TICK_TYPE * volatile const g_tick_ms_ptr = &bench_tick_ms;
+
+static bench_rx_t *bench_rx_cur;         //stream read by bench_rx_block() and bench_rx_byte()
+static uint8_t *bench_tx_dest;           //stream written by bench_tx_capture()
+static uint32_t bench_tx_len;
+static volatile uint32_t bench_sink;     //keeps results from being optimised away
+static uint32_t bench_tx_calls;          //transport calls counted by bench_tx_count()
+
+
+/**************************************************************************************************
+*                                         LOCAL PROTOTYPES
+*************************************************^************************************************/
+static uint64_t bench_now_ns   (void);
+static int      bench_cmp      (const void * a, const void * b);
+static void     bench_run      (const char * const name, bench_fptr_t fptr, void * const ctx, const uint32_t ops_per_iter, const uint32_t bytes_per_op);
+static uint32_t bench_crc_check(void);
+
+static uint16_t bench_rx_block (uint8_t * const data, const uint16_t len);
+static int16_t  bench_rx_byte  (void);
+static void     bench_rx_hndlr (pckt_inst_t * const pckt_inst, const pckt_rx_t pckt_rx);
+static void     bench_tx_capture(const uint8_t * const data, uint8_t len);
+static void     bench_tx_sink  (const uint8_t * const data, uint8_t len);
+static void     bench_tx_count (const uint8_t * const data, uint8_t len);
+static void     bench_batch_setup(bench_batch_t * const batch, const pckt_en_t enable);
+static void     bench_rx_setup (bench_rx_t * const rx, const uint8_t payload_len, const pckt_en_t block);
+
+static void     bench_task     (void * const ctx, const uint32_t iters);
+static void     bench_tx_raw   (void * const ctx, const uint32_t iters);
+static void     bench_tx_batch (void * const ctx, const uint32_t iters);
+static void     bench_sr_array (void * const ctx, const uint32_t iters);
+static void     bench_sr_loop  (void * const ctx, const uint32_t iters);
+static void     bench_unsr_array(void * const ctx, const uint32_t iters);
+static void     bench_unsr_loop(void * const ctx, const uint32_t iters);
+static void     bench_crc      (void * const ctx, const uint32_t iters);
+static void     bench_sr_u16   (void * const ctx, const uint32_t iters);
+static void     bench_sr_u32   (void * const ctx, const uint32_t iters);
+static void     bench_sr_u64   (void * const ctx, const uint32_t iters);
+static void     bench_sr_flt32 (void * const ctx, const uint32_t iters);
+static void     bench_unsr_u16 (void * const ctx, const uint32_t iters);
+static void     bench_unsr_u32 (void * const ctx, const uint32_t iters);
+static void     bench_unsr_u64 (void * const ctx, const uint32_t iters);
+static void     bench_unsr_flt32(void * const ctx, const uint32_t iters);
+static void     bench_rb_byte  (void * const ctx, const uint32_t iters);
+static void     bench_rb_block (void * const ctx, const uint32_t iters);
+static void     bench_spsc_byte(void * const ctx, const uint32_t iters);
+static void     bench_spsc_block(void * const ctx, const uint32_t iters);
+
+
+/**************************************************************************************************
+*                                            FUNCTIONS
+*************************************************^************************************************/
+int main(void)
+{
+	static const uint16_t payload_lens[] = {0, 8, 32, 128, 255};
+	static bench_rx_t rx;
+	static bench_tx_t tx;
+	static bench_batch_t batch;
+	static bench_array_t array;
+	static bench_crc_t crc;
+	static uint8_t sr_buf[BENCH_SR_VALUES * sizeof(uint64_t)];
+	static ring_buffer_t rb;
+	static volatile uint8_t rb_arr[BENCH_RB_SIZE];
+	static spsc_ring_buffer_t spsc;
+	static uint8_t spsc_arr[BENCH_RB_SIZE];
+	pckt_conf_t pckt_conf;
+	char name[64];
+	uint16_t i;
+
+	/*Every engine must match the software CRC before its speed means anything*/
+	if(bench_crc_check() != 0)
+	{
+		fprintf(stderr, "CRC SELF CHECK FAILED\n");
+		return 1;
+	}
+
+	printf("%-28s %10s %10s %10s %10s %14s %10s\n", "benchmark", "min ns", "p50 ns", "p90 ns", "max ns", "ops/s @p50", "MB/s @p50");
+
+	/*Parser, frames through pckt_task()*/
+	for(i = 0; i < (sizeof(payload_lens) / sizeof(payload_lens[0])); i++)
+	{
+		if(payload_lens[i] > MAX_PAYLOAD_LEN_BYTES) continue;
+
+		bench_rx_setup(&rx, payload_lens[i], PCKT_ENABLED);
+		snprintf(name, sizeof(name), "pckt_task block len %u", payload_lens[i]);
+		bench_run(name, bench_task, &rx, BENCH_FRAMES, payload_lens[i] + 5);
+	}
+
+	bench_rx_setup(&rx, 8, PCKT_DISABLED);
+	bench_run("pckt_task byte len 8", bench_task, &rx, BENCH_FRAMES, 8 + 5);
+
+	/*Encoder*/
+	pckt_get_config_defaults(&pckt_conf);
+	pckt_conf.tx_data_fprt = bench_tx_sink;
+	pckt_init(&tx.pckt_inst, pckt_conf);
+
+	for(i = 0; i < (sizeof(payload_lens) / sizeof(payload_lens[0])); i++)
+	{
+		if(payload_lens[i] > MAX_PAYLOAD_LEN_BYTES) continue;
+
+		tx.len = payload_lens[i];
+		snprintf(name, sizeof(name), "pckt_tx_raw len %u", payload_lens[i]);
+		bench_run(name, bench_tx_raw, &tx, 1, payload_lens[i] + 5);
+	}
+
+	/*Batching, small packets with tx_batch off and on. The counting transport costs next to nothing,
+	  on a real link each call has its own overhead and the saving is in transport calls per packet*/
+	for(i = 0; i < 2; i++)
+	{
+		bench_batch_setup(&batch, (i == 0) ? PCKT_DISABLED : PCKT_ENABLED);
+		snprintf(name, sizeof(name), "pckt_tx_raw len %u batch %s", BENCH_BATCH_LEN, (i == 0) ? "off" : "on");
+		bench_run(name, bench_tx_batch, &batch, BENCH_FRAMES, BENCH_BATCH_LEN + 5);
+
+		bench_tx_calls = 0;
+		bench_tx_batch(&batch, 1);
+		printf("%-28s %10.3f\n", "  transport calls/packet", (double)bench_tx_calls / BENCH_FRAMES);
+	}
+
+	/*Array conversion alone, one array of uint32 values per op, pckt_sr_array()/pckt_unsr_array() against a
+	  pckt_sr_u32()/pckt_unsr_u32() loop. Build with PCKT_SIMD_EN=0 for the scalar fallback*/
+	for(i = 0; i < BENCH_ARRAY_LEN; i++)
+	{
+		array.values[i] = (uint32_t)rand();
+	}
+
+	pckt_sr_array(array.bytes, array.values, BENCH_ARRAY_LEN, sizeof(uint32_t));
+
+	snprintf(name, sizeof(name), "pckt_sr_array u32 %u", (unsigned)BENCH_ARRAY_LEN);
+	bench_run(name, bench_sr_array, &array, 1, sizeof(array.values));
+	snprintf(name, sizeof(name), "pckt_sr_u32 loop %u", (unsigned)BENCH_ARRAY_LEN);
+	bench_run(name, bench_sr_loop, &array, 1, sizeof(array.values));
+	snprintf(name, sizeof(name), "pckt_unsr_array u32 %u", (unsigned)BENCH_ARRAY_LEN);
+	bench_run(name, bench_unsr_array, &array, 1, sizeof(array.values));
+	snprintf(name, sizeof(name), "pckt_unsr_u32 loop %u", (unsigned)BENCH_ARRAY_LEN);
+	bench_run(name, bench_unsr_loop, &array, 1, sizeof(array.values));
+
+	/*CRC, one 255 byte message per op*/
+	for(i = 0; i < sizeof(crc.data); i++)
+	{
+		crc.data[i] = (uint8_t)rand();
+	}
+
+	crc.crc_16_fptr = pckt_sw_crc;
+	bench_run("pckt_sw_crc 255", bench_crc, &crc, 1, sizeof(crc.data));
+	crc.crc_16_fptr = pckt_tbl_crc;
+	bench_run("pckt_tbl_crc 255", bench_crc, &crc, 1, sizeof(crc.data));
+	crc.crc_16_fptr = pckt_slice4_crc;
+	bench_run("pckt_slice4_crc 255", bench_crc, &crc, 1, sizeof(crc.data));
+	crc.crc_16_fptr = pckt_slice8_crc;
+	bench_run("pckt_slice8_crc 255", bench_crc, &crc, 1, sizeof(crc.data));
+	crc.crc_16_fptr = pckt_clmul_crc;
+	bench_run("pckt_clmul_crc 255", bench_crc, &crc, 1, sizeof(crc.data));
+
+	/*Serializers, one value per op*/
+	for(i = 0; i < sizeof(sr_buf); i++)
+	{
+		sr_buf[i] = (uint8_t)rand();
+	}
+
+	bench_run("pckt_sr_u16",     bench_sr_u16,     sr_buf, BENCH_SR_VALUES, sizeof(uint16_t));
+	bench_run("pckt_sr_u32",     bench_sr_u32,     sr_buf, BENCH_SR_VALUES, sizeof(uint32_t));
+	bench_run("pckt_sr_u64",     bench_sr_u64,     sr_buf, BENCH_SR_VALUES, sizeof(uint64_t));
+	bench_run("pckt_sr_flt32",   bench_sr_flt32,   sr_buf, BENCH_SR_VALUES, sizeof(float));
+	bench_run("pckt_unsr_u16",   bench_unsr_u16,   sr_buf, BENCH_SR_VALUES, sizeof(uint16_t));
+	bench_run("pckt_unsr_u32",   bench_unsr_u32,   sr_buf, BENCH_SR_VALUES, sizeof(uint32_t));
+	bench_run("pckt_unsr_u64",   bench_unsr_u64,   sr_buf, BENCH_SR_VALUES, sizeof(uint64_t));
+	bench_run("pckt_unsr_flt32", bench_unsr_flt32, sr_buf, BENCH_SR_VALUES, sizeof(float));
+
+	/*Ring buffers, one byte put and got per op*/
+	ring_buffer_init(&rb, rb_arr, sizeof(rb_arr));
+	bench_run("ring_buffer put/get",    bench_rb_byte,    (void *)&rb, BENCH_RB_SIZE / 2, 1);
+	bench_run("ring_buffer write/read", bench_rb_block,   (void *)&rb, BENCH_RB_SIZE / 2, 1);
+
+	spsc_ring_buffer_init(&spsc, spsc_arr, sizeof(spsc_arr));
+	bench_run("spsc_ring_buffer put/get",    bench_spsc_byte,  &spsc, BENCH_RB_SIZE / 2, 1);
+	bench_run("spsc_ring_buffer write/read", bench_spsc_block, &spsc, BENCH_RB_SIZE / 2, 1);
+
+	return 0;
+}
+
+
+/**************************************************************************************************
+*                                         LOCAL FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Monotonic time in ns
+*
+*  \note
+******************************************************************************/
+static uint64_t bench_now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/******************************************************************************
+*  \brief qsort compare for doubles
+*
+*  \note
+******************************************************************************/
+static int bench_cmp(const void * a, const void * b)
+{
+	const double x = *(const double *)a;
+	const double y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/******************************************************************************
+*  \brief Run and report one benchmark
+*
+*  \note ops_per_iter is the operations one pass of fptr does, bytes_per_op
+*        the bytes of one operation for MB/s, 0 for none
+******************************************************************************/
+static void bench_run(const char * const name, bench_fptr_t fptr, void * const ctx, const uint32_t ops_per_iter, const uint32_t bytes_per_op)
+{
+	double op_ns[BENCH_REPS];
+	uint32_t iters = 1;
+	uint64_t start;
+	uint64_t took;
+	double p50;
+	uint8_t i;
+
+	/*Size a repetition*/
+	for(;;)
+	{
+		start = bench_now_ns();
+		fptr(ctx, iters);
+		took = bench_now_ns() - start;
+
+		if((took >= BENCH_REP_NS) || (iters >= (UINT32_MAX / 2))) break;
+
+		iters = (took < (BENCH_REP_NS / 64)) ? (iters * 16) : (iters * 2);
+	}
+
+	for(i = 0; i < BENCH_WARMUP; i++)
+	{
+		fptr(ctx, iters);
+	}
+
+	for(i = 0; i < BENCH_REPS; i++)
+	{
+		start = bench_now_ns();
+		fptr(ctx, iters);
+		took = bench_now_ns() - start;
+
+		op_ns[i] = (double)took / ((double)iters * ops_per_iter);
+	}
+
+	qsort(op_ns, BENCH_REPS, sizeof(op_ns[0]), bench_cmp);
+
+	p50 = op_ns[BENCH_REPS / 2];
+
+	printf("%-28s %10.2f %10.2f %10.2f %10.2f %14.0f", name, op_ns[0], p50, op_ns[(BENCH_REPS * 9) / 10], op_ns[BENCH_REPS - 1], 1e9 / p50);
+
+	if(bytes_per_op > 0)
+	{
+		printf(" %10.1f", (bytes_per_op * 1e3) / p50);
+	}
+
+	printf("\n");
+}
+
+/******************************************************************************
+*  \brief CRC self check
+*
+*  \note compares every engine of pckt_crc.h against pckt_sw_crc() and
+*        pckt_sw_crc32c_update() for every length from 0 to 255 at each of
+*        BENCH_CRC_OFFSETS start offsets, the update versions also from a
+*        nonzero crc and split in two calls. Prints each mismatch, returns
+*        the number found
+******************************************************************************/
+static uint32_t bench_crc_check(void)
+{
+	static const bench_crc_engine_t engines[] =
+	{
+		{"tbl",    pckt_tbl_crc,    pckt_tbl_crc_update},
+		{"slice4", pckt_slice4_crc, pckt_slice4_crc_update},
+		{"slice8", pckt_slice8_crc, pckt_slice8_crc_update},
+		{"clmul",  pckt_clmul_crc,  pckt_clmul_crc_update},
+	};
+	static const bench_crc32_engine_t engines_32[] =
+	{
+		{"tbl crc32c", pckt_tbl_crc32c_update},
+		{"hw crc32c",  pckt_hw_crc32c_update},
+	};
+	uint8_t data[UINT8_MAX + BENCH_CRC_OFFSETS];
+	const uint8_t *msg;
+	uint32_t fails = 0;
+	uint16_t len;
+	uint16_t half;
+	uint8_t offset;
+	uint8_t i;
+	crc_t expect;
+	crc_t got;
+	uint32_t expect_32;
+	uint32_t got_32;
+
+	for(len = 0; len < sizeof(data); len++)
+	{
+		data[len] = (uint8_t)rand();
+	}
+
+	for(offset = 0; offset < BENCH_CRC_OFFSETS; offset++)
+	{
+		for(len = 0; len <= UINT8_MAX; len++)
+		{
+			msg  = &data[offset];
+			half = len / 2;
+
+			/*CRC-16*/
+			expect = pckt_sw_crc(msg, (uint8_t)len);
+
+			for(i = 0; i < (sizeof(engines) / sizeof(engines[0])); i++)
+			{
+				got = engines[i].crc_16_fptr(msg, (uint8_t)len);
+
+				if(got != expect)
+				{
+					fprintf(stderr, "crc mismatch %s offset %u len %u: %04X expected %04X\n", engines[i].name, offset, len, got, expect);
+					fails++;
+				}
+
+				got = engines[i].crc_16_update_fptr(engines[i].crc_16_update_fptr(0xFFFF, msg, half), &msg[half], len - half);
+
+				if(got != pckt_sw_crc_update(0xFFFF, msg, len))
+				{
+					fprintf(stderr, "crc mismatch %s_update offset %u len %u\n", engines[i].name, offset, len);
+					fails++;
+				}
+			}
+
+			/*CRC-32C*/
+			expect_32 = pckt_sw_crc32c_update(0, msg, len);
+
+			for(i = 0; i < (sizeof(engines_32) / sizeof(engines_32[0])); i++)
+			{
+				got_32 = engines_32[i].crc_32_update_fptr(0, msg, len);
+
+				if(got_32 != expect_32)
+				{
+					fprintf(stderr, "crc mismatch %s offset %u len %u: %08X expected %08X\n", engines_32[i].name, offset, len, (unsigned)got_32, (unsigned)expect_32);
+					fails++;
+				}
+
+				got_32 = engines_32[i].crc_32_update_fptr(engines_32[i].crc_32_update_fptr(0, msg, half), &msg[half], len - half);
+
+				if(got_32 != expect_32)
+				{
+					fprintf(stderr, "crc mismatch %s split offset %u len %u\n", engines_32[i].name, offset, len);
+					fails++;
+				}
+			}
+		}
+	}
+
+	return fails;
+}
+
+/******************************************************************************
+*  \brief Stream readers and handler for pckt_task()
+*
+*  \note
+******************************************************************************/
+static uint16_t bench_rx_block(uint8_t * const data, const uint16_t len)
+{
+	bench_rx_t * const rx = bench_rx_cur;
+	uint32_t num = rx->stream_len - rx->stream_pos;
+
+	if(num > len) num = len;
+
+	memcpy(data, &rx->stream[rx->stream_pos], num);
+	rx->stream_pos += num;
+
+	return (uint16_t)num;
+}
+
+static int16_t bench_rx_byte(void)
+{
+	bench_rx_t * const rx = bench_rx_cur;
+
+	if(rx->stream_pos >= rx->stream_len) return -1;
+
+	return rx->stream[rx->stream_pos++];
+}
+
+static void bench_rx_hndlr(pckt_inst_t * const pckt_inst, const pckt_rx_t pckt_rx)
+{
+	(void)pckt_inst;
+
+	bench_sink += pckt_rx.id;
+}
+
+/******************************************************************************
+*  \brief Transmit functions, capture into a stream or drop
+*
+*  \note
+******************************************************************************/
+static void bench_tx_capture(const uint8_t * const data, uint8_t len)
+{
+	memcpy(&bench_tx_dest[bench_tx_len], data, len);
+	bench_tx_len += len;
+}
+
+static void bench_tx_sink(const uint8_t * const data, uint8_t len)
+{
+	bench_sink += data[len - 1];
+}
+
+static void bench_tx_count(const uint8_t * const data, uint8_t len)
+{
+	bench_sink += data[len - 1];
+	bench_tx_calls++;
+}
+
+/******************************************************************************
+*  \brief Set up batched transmit
+*
+*  \note with enable off every packet is its own tx_data_fprt call
+******************************************************************************/
+static void bench_batch_setup(bench_batch_t * const batch, const pckt_en_t enable)
+{
+	pckt_conf_t pckt_conf;
+
+	memset(batch->payload, 0x5A, sizeof(batch->payload));
+
+	pckt_get_config_defaults(&pckt_conf);
+	pckt_conf.tx_data_fprt       = bench_tx_count;
+	pckt_conf.crc_16_fptr        = pckt_slice8_crc;
+	pckt_conf.crc_16_update_fptr = pckt_slice8_crc_update;
+
+	if(enable == PCKT_ENABLED)
+	{
+		pckt_conf.tx_batch_buffer    = batch->batch_buffer;
+		pckt_conf.tx_batch_size      = sizeof(batch->batch_buffer);
+		pckt_conf.tx_batch_threshold = sizeof(batch->batch_buffer);
+	}
+
+	pckt_init(&batch->pckt_inst, pckt_conf);
+}
+
+/******************************************************************************
+*  \brief Set up a pckt_task() stream of BENCH_FRAMES frames
+*
+*  \note block selects rx_block_fptr, otherwise bytes come one at a time
+*        through rx_byte_fptr
+******************************************************************************/
+static void bench_rx_setup(bench_rx_t * const rx, const uint8_t payload_len, const pckt_en_t block)
+{
+	pckt_conf_t pckt_conf;
+	pckt_inst_t enc;
+	uint8_t payload[UINT8_MAX];
+	uint16_t i;
+
+	for(i = 0; i < sizeof(payload); i++)
+	{
+		payload[i] = (uint8_t)rand();
+	}
+
+	/*Encode the stream*/
+	pckt_get_config_defaults(&pckt_conf);
+	pckt_conf.tx_data_fprt = bench_tx_capture;
+	pckt_init(&enc, pckt_conf);
+
+	bench_tx_dest = rx->stream;
+	bench_tx_len  = 0;
+
+	for(i = 0; i < BENCH_FRAMES; i++)
+	{
+		pckt_tx_raw(&enc, i, payload, payload_len);
+	}
+
+	rx->stream_len = bench_tx_len;
+	rx->stream_pos = 0;
+
+	/*Parser*/
+	pckt_get_config_defaults(&pckt_conf);
+	pckt_conf.rx_block_fptr  = (block == PCKT_ENABLED) ? bench_rx_block : 0;
+	pckt_conf.rx_byte_fptr   = bench_rx_byte;
+	pckt_conf.tx_data_fprt   = bench_tx_sink;
+	pckt_conf.rx_buffer      = rx->rx_buffer;
+	pckt_conf.rx_buffer_size = RX_BUFFER_LEN_BYTES;
+	pckt_init(&rx->pckt_inst, pckt_conf);
+}
+
+/******************************************************************************
+*  \brief pckt_task() over the stream, BENCH_FRAMES frames per pass
+*
+*  \note
+******************************************************************************/
+static void bench_task(void * const ctx, const uint32_t iters)
+{
+	bench_rx_t * const rx = (bench_rx_t *)ctx;
+	uint32_t i;
+
+	bench_rx_cur = rx;
+
+	for(i = 0; i < iters; i++)
+	{
+		rx->stream_pos = 0;
+
+		while(rx->stream_pos < rx->stream_len)
+		{
+			pckt_task(&rx->pckt_inst, bench_rx_hndlr);
+		}
+	}
+}
+
+/******************************************************************************
+*  \brief pckt_tx_raw(), one frame per pass
+*
+*  \note
+******************************************************************************/
+static void bench_tx_raw(void * const ctx, const uint32_t iters)
+{
+	bench_tx_t * const tx = (bench_tx_t *)ctx;
+	uint32_t i;
+
+	for(i = 0; i < iters; i++)
+	{
+		pckt_tx_raw(&tx->pckt_inst, (uint16_t)i, tx->payload, tx->len);
+	}
+}
+
+/******************************************************************************
+*  \brief Small packets, BENCH_FRAMES and a flush per pass
+*
+*  \note
+******************************************************************************/
+static void bench_tx_batch(void * const ctx, const uint32_t iters)
+{
+	bench_batch_t * const batch = (bench_batch_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		for(j = 0; j < BENCH_FRAMES; j++)
+		{
+			pckt_tx_raw(&batch->pckt_inst, j, batch->payload, sizeof(batch->payload));
+		}
+
+		pckt_flush_tx(&batch->pckt_inst);
+	}
+}
+
+/******************************************************************************
+*  \brief uint32 array conversion, one array per pass
+*
+*  \note the loop versions convert one value at a time, as done without the
+*        array functions. One value changes every pass and one result goes to
+*        bench_sink so passes can not be merged
+******************************************************************************/
+static void bench_sr_array(void * const ctx, const uint32_t iters)
+{
+	bench_array_t * const array = (bench_array_t *)ctx;
+	uint32_t i;
+
+	for(i = 0; i < iters; i++)
+	{
+		array->values[0] = i;
+		pckt_sr_array(array->bytes, array->values, BENCH_ARRAY_LEN, sizeof(uint32_t));
+		bench_sink += array->bytes[sizeof(array->bytes) - 1];
+	}
+}
+
+static void bench_sr_loop(void * const ctx, const uint32_t iters)
+{
+	bench_array_t * const array = (bench_array_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		array->values[0] = i;
+
+		for(j = 0; j < BENCH_ARRAY_LEN; j++)
+		{
+			pckt_sr_u32(&array->bytes[j * sizeof(uint32_t)], array->values[j]);
+		}
+
+		bench_sink += array->bytes[sizeof(array->bytes) - 1];
+	}
+}
+
+static void bench_unsr_array(void * const ctx, const uint32_t iters)
+{
+	bench_array_t * const array = (bench_array_t *)ctx;
+	uint32_t i;
+
+	for(i = 0; i < iters; i++)
+	{
+		array->bytes[0] = (uint8_t)i;
+		pckt_unsr_array(array->values, array->bytes, BENCH_ARRAY_LEN, sizeof(uint32_t));
+		bench_sink += array->values[BENCH_ARRAY_LEN - 1];
+	}
+}
+
+static void bench_unsr_loop(void * const ctx, const uint32_t iters)
+{
+	bench_array_t * const array = (bench_array_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		array->bytes[0] = (uint8_t)i;
+
+		for(j = 0; j < BENCH_ARRAY_LEN; j++)
+		{
+			array->values[j] = pckt_unsr_u32(&array->bytes[j * sizeof(uint32_t)]);
+		}
+
+		bench_sink += array->values[BENCH_ARRAY_LEN - 1];
+	}
+}
+
+/******************************************************************************
+*  \brief CRC-16 of the 255 byte message, one per pass
+*
+*  \note the first byte changes every pass so calls can not be merged
+******************************************************************************/
+static void bench_crc(void * const ctx, const uint32_t iters)
+{
+	bench_crc_t * const crc = (bench_crc_t *)ctx;
+	crc_t sum = 0;
+	uint32_t i;
+
+	for(i = 0; i < iters; i++)
+	{
+		crc->data[0] = (uint8_t)i;
+		sum ^= crc->crc_16_fptr(crc->data, sizeof(crc->data));
+	}
+
+	bench_sink += sum;
+}
+
+/******************************************************************************
+*  \brief Serializers, BENCH_SR_VALUES values per pass
+*
+*  \note unsr stores every value to the volatile sink, so the loads can not
+*        be merged, vectorized or dropped
+******************************************************************************/
+static void bench_sr_u16(void * const ctx, const uint32_t iters)
+{
+	uint8_t * const buf = (uint8_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		for(j = 0; j < BENCH_SR_VALUES; j++)
+		{
+			pckt_sr_u16(&buf[j * sizeof(uint16_t)], (uint16_t)(i + j));
+		}
+	}
+}
+
+static void bench_sr_u32(void * const ctx, const uint32_t iters)
+{
+	uint8_t * const buf = (uint8_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		for(j = 0; j < BENCH_SR_VALUES; j++)
+		{
+			pckt_sr_u32(&buf[j * sizeof(uint32_t)], i + j);
+		}
+	}
+}
+
+static void bench_sr_u64(void * const ctx, const uint32_t iters)
+{
+	uint8_t * const buf = (uint8_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		for(j = 0; j < BENCH_SR_VALUES; j++)
+		{
+			pckt_sr_u64(&buf[j * sizeof(uint64_t)], ((uint64_t)i << 32) | j);
+		}
+	}
+}
+
+static void bench_sr_flt32(void * const ctx, const uint32_t iters)
+{
+	uint8_t * const buf = (uint8_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		for(j = 0; j < BENCH_SR_VALUES; j++)
+		{
+			pckt_sr_flt32(&buf[j * sizeof(float)], (float)(i + j));
+		}
+	}
+}
+
+static void bench_unsr_u16(void * const ctx, const uint32_t iters)
+{
+	uint8_t * const buf = (uint8_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		for(j = 0; j < BENCH_SR_VALUES; j++)
+		{
+			bench_sink = pckt_unsr_u16(&buf[j * sizeof(uint16_t)]);
+		}
+	}
+}
+
+static void bench_unsr_u32(void * const ctx, const uint32_t iters)
+{
+	uint8_t * const buf = (uint8_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		for(j = 0; j < BENCH_SR_VALUES; j++)
+		{
+			bench_sink = pckt_unsr_u32(&buf[j * sizeof(uint32_t)]);
+		}
+	}
+}
+
+static void bench_unsr_u64(void * const ctx, const uint32_t iters)
+{
+	uint8_t * const buf = (uint8_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		for(j = 0; j < BENCH_SR_VALUES; j++)
+		{
+			bench_sink = (uint32_t)pckt_unsr_u64(&buf[j * sizeof(uint64_t)]);
+		}
+	}
+}
+
+static void bench_unsr_flt32(void * const ctx, const uint32_t iters)
+{
+	uint8_t * const buf = (uint8_t *)ctx;
+	float value;
+	uint32_t bits;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		for(j = 0; j < BENCH_SR_VALUES; j++)
+		{
+			value = pckt_unsr_flt32(&buf[j * sizeof(float)]);
+			memcpy(&bits, &value, sizeof(bits));
+			bench_sink = bits;
+		}
+	}
+}
+
+/******************************************************************************
+*  \brief Ring buffers, half the buffer put and got per pass
+*
+*  \note
+******************************************************************************/
+static void bench_rb_byte(void * const ctx, const uint32_t iters)
+{
+	ring_buffer_t * const rb = (ring_buffer_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		for(j = 0; j < (BENCH_RB_SIZE / 2); j++)
+		{
+			ring_buffer_put_data(rb, (uint8_t)j);
+		}
+
+		for(j = 0; j < (BENCH_RB_SIZE / 2); j++)
+		{
+			bench_sink += (uint32_t)ring_buffer_get_data(rb);
+		}
+	}
+}
+
+static void bench_rb_block(void * const ctx, const uint32_t iters)
+{
+	ring_buffer_t * const rb = (ring_buffer_t *)ctx;
+	uint8_t data[BENCH_RB_SIZE / 2];
+	uint32_t i;
+
+	memset(data, 0x5A, sizeof(data));
+
+	for(i = 0; i < iters; i++)
+	{
+		ring_buffer_write(rb, data, sizeof(data));
+		bench_sink += ring_buffer_read(rb, data, sizeof(data));
+	}
+}
+
+static void bench_spsc_byte(void * const ctx, const uint32_t iters)
+{
+	spsc_ring_buffer_t * const spsc = (spsc_ring_buffer_t *)ctx;
+	uint32_t i;
+	uint16_t j;
+
+	for(i = 0; i < iters; i++)
+	{
+		for(j = 0; j < (BENCH_RB_SIZE / 2); j++)
+		{
+			spsc_ring_buffer_put_data(spsc, (uint8_t)j);
+		}
+
+		for(j = 0; j < (BENCH_RB_SIZE / 2); j++)
+		{
+			bench_sink += (uint32_t)spsc_ring_buffer_get_data(spsc);
+		}
+	}
+}
+
+static void bench_spsc_block(void * const ctx, const uint32_t iters)
+{
+	spsc_ring_buffer_t * const spsc = (spsc_ring_buffer_t *)ctx;
+	uint8_t data[BENCH_RB_SIZE / 2];
+	uint32_t i;
+
+	memset(data, 0x5A, sizeof(data));
+
+	for(i = 0; i < iters; i++)
+	{
+		spsc_ring_buffer_write(spsc, data, sizeof(data));
+		bench_sink += spsc_ring_buffer_read(spsc, data, sizeof(data));
+	}
+}
@@ -11,6 +11,7 @@
 #include "./ring_buffer/ring_buffer.h"
 
 #include "packet.h"
+#include "pckt_sr.h"
 
 
 /**************************************************************************************************
@@ -18,34 +19,6 @@
 *************************************************^************************************************/
 #define PACKET_RX_TIMEOUT_MS 10
 
-
-typedef union bit8_dat_t
-{
-	uint8_t _uint;
-	int8_t _int;
-} bit8_dat_t;
-
-typedef union bit16_dat_t
-{
-	uint16_t _uint;
-	int16_t _int;
-} bit16_dat_t;
-
-typedef union bit32_dat_t
-{
-	uint32_t _uint;
-	int32_t _int;
-	float _flt;
-} bit32_dat_t;
-
-typedef union bit64_dat_t
-{
-	uint64_t _uint;
-	int64_t _int;
-	double _dbl;
-} bit64_dat_t;
-
-
 /**************************************************************************************************
 *                                         LOCAL PROTOTYPES
 *************************************************^************************************************/
@@ -299,12 +272,7 @@ static int16_t a_rx_byte(void)
 ******************************************************************************/
 static void a_tx_data(const uint8_t * const data, uint32_t length)
 {
-	uint32_t i = 0;
-
-	for(i = 0; i < length; i++)
-	{
-		ring_buffer_put_data(&a_buff, data[i]);
-	}
+	ring_buffer_write(&a_buff, data, (uint16_t)length);
 }
 
 /******************************************************************************
@@ -329,12 +297,7 @@ static int16_t b_rx_byte(void)
 ******************************************************************************/
 static void b_tx_data(const uint8_t * const data, uint32_t length)
 {
-	uint32_t i = 0;
-
-	for(i = 0; i < length; i++)
-	{
-		ring_buffer_put_data(&b_buff, data[i]);
-	}
+	ring_buffer_write(&b_buff, data, (uint16_t)length);
 }
 
 /******************************************************************************
@@ -31,14 +31,35 @@
 *  0   1   2   3   4   5   6
 * [DE][AD][02][BE][EF][74][19]
 *
+* Extended frames (conf.ext_len), LEN is 2 bytes and CRC is CRC-32C (Castagnoli) over the same
+* bytes, for payloads over 255 bytes. Both ends must be configured the same.
+*
+* [ID:1, ID:0][LEN:1, LEN:0][PAYLOAD:n, ...,  PAYLOAD:0][CRC32:3, CRC32:2, CRC32:1, CRC32:0]
+*
 * NOTE:
 *	This code should be independant of endianness of the host system, but it was only
 *	tested on a little endian processor.
 */
 
 
+#include <string.h>
+
 #include "packet.h"
 #include "timer.h"
+#include "pckt_sr.h"
+
+/*Vector byte swap for array conversion, little endian hosts only. Define PCKT_SIMD_EN=0 to use the scalar loop*/
+#ifndef PCKT_SIMD_EN
+#define PCKT_SIMD_EN 1
+#endif
+
+#if PCKT_SIMD_EN && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#include <emmintrin.h>
+#define BSWAP_SSE2
+#elif PCKT_SIMD_EN && defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_neon.h>
+#define BSWAP_NEON
+#endif
 
 /**************************************************************************************************
 *                                             DEFINES
@@ -51,46 +72,71 @@
 #define CRC1_POS(payload_data_len)   (DATA_0_POS(payload_data_len) + 1)
 #define CRC0_POS(payload_data_len)   (CRC1_POS(payload_data_len) + 1)
 
-#define UNSERIALIZE_UINT16(msbyt, lsbyt) ( (((uint16_t)msbyt) << 8) | (uint16_t)lsbyt )
+#define EXT_HDR_LEN 4 //[ID:1, ID:0][LEN:1, LEN:0]
+#define EXT_CRC_LEN 4 //[CRC32:3 ... CRC32:0]
+#define CRC32C_POLYNOMIAL 0x82F63B78 //reflected 0x1EDC6F41
 
-typedef union bit8_dat_t
-{
-	uint8_t _uint;
-	int8_t _int;
-} bit8_dat_t;
+#define TX_ARRAY_CHUNK_LEN (((MAX_PAYLOAD_LEN_BYTES + 7) / 8) * 8) //stack chunk tx_array() serializes into, MAX_PAYLOAD_LEN_BYTES rounded up to whole 64 bit values
 
-typedef union bit16_dat_t
-{
-	uint16_t _uint;
-	int16_t _int;
-} bit16_dat_t;
+#define CRC_INIT(pckt_inst) (((pckt_inst)->conf.ext_len == PCKT_ENABLED) ? 0 : (pckt_inst)->conf.crc_16_init)
 
-typedef union bit32_dat_t
-{
-	uint32_t _uint;
-	int32_t _int;
-	float _flt;
-} bit32_dat_t;
+#define UNSERIALIZE_UINT16(msbyt, lsbyt) ( (((uint16_t)msbyt) << 8) | (uint16_t)lsbyt )
 
-typedef union bit64_dat_t
+#if PCKT_STATS_EN
+#define STATS_ADD(pckt_inst, field, num) ((pckt_inst)->stats.field += (num))
+#else
+#define STATS_ADD(pckt_inst, field, num)
+#endif
+
+#if PCKT_PROF_EN
+#define PROF_START(pckt_inst, stage_id, start) const uint8_t start##_due = pckt_prof_due(&(pckt_inst)->prof, (stage_id)); \
+                                               const pckt_prof_tick_t start = (start##_due ? PCKT_PROF_NOW() : 0)
+#define PROF_END(pckt_inst, stage_id, start)   do { if(start##_due) pckt_prof_add(&(pckt_inst)->prof, (stage_id), (pckt_prof_tick_t)(PCKT_PROF_NOW() - (start))); } while(0)
+#else
+#define PROF_START(pckt_inst, stage_id, start)
+#define PROF_END(pckt_inst, stage_id, start)
+#endif
+
+/*Command handler, one of the two is set*/
+typedef struct rx_handler_t
 {
-	uint64_t _uint;
-	int64_t _int;
-	double _dbl;
-} bit64_dat_t;
+	void(*cmd_handler_fptr)(pckt_inst_t * const, const pckt_rx_t);
+	void(*view_handler_fptr)(pckt_inst_t * const, const pckt_view_t * const);
+} rx_handler_t;
 
 
 /**************************************************************************************************
 *                                         LOCAL PROTOTYPES
 *************************************************^************************************************/
 static int16_t     dflt_rx_byte   (void);
+static uint16_t    rx_payload_len (const pckt_inst_t * const pckt_inst);
+static uint16_t    rx_frame_len   (const pckt_inst_t * const pckt_inst);
+static void        rx_task        (pckt_inst_t * const pckt_inst, const rx_handler_t * const handler);
+static void        rx_feed        (pckt_inst_t * const pckt_inst, const uint8_t * data, size_t len, const rx_handler_t * const handler);
+static void        rx_scan        (pckt_inst_t * const pckt_inst, const rx_handler_t * const handler);
+static void        rx_frame       (pckt_inst_t * const pckt_inst, const rx_handler_t * const handler);
+static void        rx_crc_run     (pckt_inst_t * const pckt_inst);
+static void        rx_clear       (pckt_inst_t * const pckt_inst);
+static void        rx_drop        (pckt_inst_t * const pckt_inst, const uint16_t num_bytes);
+static void        rx_compact     (pckt_inst_t * const pckt_inst);
+static crc_t       calc_crc       (const pckt_inst_t * const pckt_inst, const uint8_t * const data, const uint16_t len);
+static uint8_t     crc_match      (const pckt_conf_t * const pckt_conf);
+static void        tx_data        (const pckt_inst_t * const pckt_inst, const uint8_t * data, uint16_t len);
+static uint8_t     tx_hdr         (const pckt_inst_t * const pckt_inst, uint8_t * const hdr, const uint16_t id, const uint16_t len);
+static uint16_t    tx_build       (const pckt_inst_t * const pckt_inst, uint8_t * const pckt, const uint16_t id, const pckt_tx_seg_t * const segs, const uint8_t num_segs, const uint16_t len);
+static void        tx_vec         (const pckt_inst_t * const pckt_inst, const uint16_t id, const pckt_tx_seg_t * const segs, const uint8_t num_segs, const uint16_t len);
+static void        tx_seg         (const pckt_inst_t * const pckt_inst, const uint8_t * const data, const uint16_t len);
+static void        tx_array       (pckt_inst_t * const pckt_inst, const uint16_t id, const void * const data, uint16_t count, const uint8_t width);
+static pckt_rx_valid_t rx_array   (pckt_inst_t * const pckt_inst, void * const dest, const uint8_t width, const uint16_t max_count, uint16_t * const count);
+static uint32_t    crc_next       (const pckt_inst_t * const pckt_inst, const uint32_t crc, const uint8_t * const data, const uint16_t len);
+static uint8_t     crc_put        (const pckt_inst_t * const pckt_inst, const uint32_t crc, uint8_t * const dest);
 static void        dflt_tx_data   (const uint8_t * const data, const uint8_t length);
-static bit16_dat_t unsr_16        (const uint8_t * const big_endian_data);
-static bit32_dat_t unsr_32        (const uint8_t * const big_endian_data);
-static bit64_dat_t unsr_64        (const uint8_t * const big_endian_data);
-static void        sr_16          (uint8_t * const dest, const uint16_t src);
-static void        sr_32          (uint8_t * const dest, const uint32_t src);
-static void        sr_64          (uint8_t * const dest, const uint64_t src);
+static uint16_t    bswap_simd     (uint8_t * const dest, const uint8_t * const src, const uint16_t num_bytes, const uint8_t width);
+static void        stats_id       (pckt_inst_t * const pckt_inst, const uint16_t id, const uint16_t len);
+static void        err_task       (pckt_inst_t * const pckt_inst);
+static void        tick_remain    (const TICK_TYPE now, const TICK_TYPE since, const TICK_TYPE limit, TICK_TYPE * const remain, uint8_t * const found);
+static uint8_t     err_ready      (pckt_inst_t * const pckt_inst, const uint8_t ind);
+static void        err_tx         (pckt_inst_t * const pckt_inst, const pckt_err_id_t error, const uint16_t id);
 
 
 /**************************************************************************************************
@@ -104,133 +150,179 @@ static void        sr_64          (uint8_t * const dest, const uint64_t src);
 void pckt_get_config_defaults(pckt_conf_t * const pckt_conf)
 {
 	pckt_conf->rx_byte_fptr          = dflt_rx_byte;
+	pckt_conf->rx_block_fptr         = 0;
 	pckt_conf->tx_data_fprt          = dflt_tx_data;
+	pckt_conf->tx_vec_fptr           = 0;
 	pckt_conf->crc_16_fptr           = pckt_sw_crc;
+	pckt_conf->crc_16_update_fptr    = pckt_sw_crc_update;
+	pckt_conf->crc_16_init           = 0;
+	pckt_conf->crc_16_xor_out        = 0;
+	pckt_conf->crc_32_update_fptr    = pckt_sw_crc32c_update;
+	pckt_conf->ext_len               = PCKT_DISABLED;
+	pckt_conf->crc_running           = PCKT_DISABLED;
+	pckt_conf->resync                = PCKT_DISABLED;
+	pckt_conf->tick_ptr              = 0;
+	pckt_conf->tick_fptr             = 0;
 	pckt_conf->clear_buffer_timeout  = 1000;
 	pckt_conf->enable                = PCKT_ENABLED;
-	pckt_conf->err_rply              = PCKT_ENABLED;
+	pckt_conf->err_rply              = PCKT_ERR_RPLY_IMMEDIATE;
+	pckt_conf->err_summary_period    = 1000;
+	pckt_conf->tx_batch_buffer       = 0;
+	pckt_conf->tx_batch_size         = 0;
+	pckt_conf->tx_batch_threshold    = 0;
+	pckt_conf->tx_batch_timeout      = 0;
+	pckt_conf->rx_buffer             = 0;
+	pckt_conf->rx_buffer_size        = 0;
+
+	memset(pckt_conf->err_rply_interval, 0, sizeof(pckt_conf->err_rply_interval));
 }
 
 /******************************************************************************
 *  \brief Packet init
 *
-*  \note
+*  \note returns -1 and leaves the instance disabled when the instance uses
+*        crc_16_update_fptr (crc_running, tx_vec_fptr or frames longer than
+*        crc_16_fptr takes) and it gives a different crc than crc_16_fptr.
+*        Also with PCKT_RX_BUFFER_EMBED_EN=0 and no conf.rx_buffer
 ******************************************************************************/
-void pckt_init(pckt_inst_t * const pckt_inst, const pckt_conf_t pckt_conf)
+int8_t pckt_init(pckt_inst_t * const pckt_inst, const pckt_conf_t pckt_conf)
 {
+	uint8_t crc_update_used;
+
 	/*Conf*/
 	pckt_inst->conf = pckt_conf;
 
+#if PCKT_TICK_GLOBAL_EN
+	if(pckt_inst->conf.tick_ptr == 0)
+	{
+		pckt_inst->conf.tick_ptr = g_tick_ms_ptr;
+	}
+#endif
+
 	/*Inst*/
+	pckt_inst->dispatch             = 0;
+	pckt_inst->rx_hook              = 0;
 	pckt_inst->rx_byte              = 0;
-	pckt_inst->rx_buffer_ind        = 0;
 	pckt_inst->calc_crc_16_checksum = 0;
-	tmrReset(&pckt_inst->last_tick);
+	pckt_inst->rx_resyncing         = 0;
+	pckt_inst->tx_batch_len         = 0;
+	pckt_inst->err_sent             = 0;
+	pckt_inst->err_pend             = 0;
+
+	memset(pckt_inst->err_count, 0, sizeof(pckt_inst->err_count));
+
+	/*Framing*/
+	if(pckt_conf.ext_len == PCKT_ENABLED)
+	{
+		pckt_inst->hdr_len = EXT_HDR_LEN;
+		pckt_inst->crc_len = EXT_CRC_LEN;
+	}
+	else
+	{
+		pckt_inst->hdr_len = DATA_N_POS;
+		pckt_inst->crc_len = sizeof(crc_t);
+	}
+
+	/*Receive buffer*/
+	if((pckt_conf.rx_buffer != 0) && (pckt_conf.rx_buffer_size > (pckt_inst->hdr_len + pckt_inst->crc_len)))
+	{
+		pckt_inst->rx_buffer       = pckt_conf.rx_buffer;
+		pckt_inst->max_payload_len = pckt_conf.rx_buffer_size - (pckt_inst->hdr_len + pckt_inst->crc_len);
+	}
+	else
+	{
+#if PCKT_RX_BUFFER_EMBED_EN
+		pckt_inst->rx_buffer       = pckt_inst->rx_buffer_arr;
+		pckt_inst->max_payload_len = MAX_PAYLOAD_LEN_BYTES;
+#else
+		pckt_inst->rx_buffer       = 0;
+		pckt_inst->max_payload_len = 0;
+#endif
+	}
+
+	/*Only 8 bits of LEN without ext_len*/
+	if((pckt_conf.ext_len != PCKT_ENABLED) && (pckt_inst->max_payload_len > UINT8_MAX))
+	{
+		pckt_inst->max_payload_len = UINT8_MAX;
+	}
+
+	rx_clear(pckt_inst);
+	pckt_stats_reset(pckt_inst);
+#if PCKT_PROF_EN
+	pckt_prof_reset(&pckt_inst->prof);
+#endif
+	pckt_inst->last_tick        = pckt_get_tick(pckt_inst);
+	pckt_inst->tx_batch_tick    = pckt_inst->last_tick;
+	pckt_inst->err_summary_tick = pckt_inst->last_tick;
+
+	/*CRC-16 functions must agree where both are used*/
+	crc_update_used = (pckt_conf.ext_len != PCKT_ENABLED) &&
+	                  ((pckt_conf.crc_running == PCKT_ENABLED) || (pckt_conf.tx_vec_fptr != 0) ||
+	                   (pckt_inst->max_payload_len > MAX_PAYLOAD_LEN_BYTES) || ((pckt_inst->hdr_len + pckt_inst->max_payload_len) > UINT8_MAX));
+
+	/*Without the embedded buffer conf.rx_buffer is required*/
+	if((crc_update_used && !crc_match(&pckt_conf)) || (pckt_inst->rx_buffer == 0))
+	{
+		pckt_inst->conf.enable = PCKT_DISABLED;
+		return -1;
+	}
+
+	return 0;
 }
 
 /******************************************************************************
 *  \brief Packet task
 *
 *  \note takes pointer to instance and function pointer to command handler
+*        if rx_block_fptr is set up to PCKT_RX_BLOCK_LEN_BYTES are read and
+*        parsed per call, otherwise one byte is read through rx_byte_fptr
 ******************************************************************************/
 void pckt_task(pckt_inst_t * const pckt_inst, void(*cmd_handler_fptr)(pckt_inst_t * const, const pckt_rx_t))
 {
-	uint8_t i;
-	
-	/*If packet is disabled do not run*/
-	if(pckt_inst->conf.enable == PCKT_DISABLED) return;
+	const rx_handler_t handler = {cmd_handler_fptr, 0};
 
-	/*Get byte*/
-	pckt_inst->rx_byte = pckt_inst->conf.rx_byte_fptr();
-
-	/*Check for received byte*/
-	if(pckt_inst->rx_byte != -1)
-	{
-		/*Record time of last byte*/
-		tmrReset(&pckt_inst->last_tick);
+	rx_task(pckt_inst, &handler);
+}
 
-		/*Is received buffer full?*/
-		if(pckt_inst->rx_buffer_ind == RX_BUFFER_LEN_BYTES)
-		{
-			/*Set to the last byte*/
-			pckt_inst->rx_buffer_ind -= 1;
+/******************************************************************************
+*  \brief Packet task, zero copy
+*
+*  \note same as pckt_task() but the handler gets a view of the packet in the
+*        receive buffer instead of a copy, see pckt_view_t for lifetime
+******************************************************************************/
+void pckt_task_view(pckt_inst_t * const pckt_inst, void(*view_handler_fptr)(pckt_inst_t * const, const pckt_view_t * const))
+{
+	const rx_handler_t handler = {0, view_handler_fptr};
 
-			/*Making it here means the received buffer is full*/
-		}
-		else
-        {
-            /*Put received byte in buffer*/
-            pckt_inst->rx_buffer[pckt_inst->rx_buffer_ind] = (uint8_t)pckt_inst->rx_byte;
-            pckt_inst->rx_buffer_ind++;
-        }
-
-		/*Check for valid packet - after ID:0 ID:1 and LEN bytes received*/
-		if(pckt_inst->rx_buffer_ind >= 3)
-		{
-			/*Copy LEN*/
-			pckt_inst->pckt_rx.len = pckt_inst->rx_buffer[LEN_POS];
+	rx_task(pckt_inst, &handler);
+}
 
-			/*Verify LEN*/
-			if(pckt_inst->pckt_rx.len > MAX_PAYLOAD_LEN_BYTES)
-			{
-				/*If not going to fit force it down to the max*/
-				pckt_inst->pckt_rx.len = MAX_PAYLOAD_LEN_BYTES;
-			}
+/******************************************************************************
+*  \brief Packet feed
+*
+*  \note parses a block of received bytes, the command handler is run for every
+*        complete packet in the block. Partial packets are kept for the next
+*        call. Timeout of partial packets is still handled by pckt_task().
+*        Do not feed the same instance from inside its handler.
+******************************************************************************/
+void pckt_feed(pckt_inst_t * const pckt_inst, const uint8_t * data, size_t len, void(*cmd_handler_fptr)(pckt_inst_t * const, const pckt_rx_t))
+{
+	const rx_handler_t handler = {cmd_handler_fptr, 0};
 
-			/*Check data received to see if all bytes received - the +5 is [ID:0, ID:1][LEN][CRC16:0, CRC16:1]*/
-			if((pckt_inst->pckt_rx.len + 5u) == pckt_inst->rx_buffer_ind)
-			{
-				/*Calculate checksum - performed on [ID:0, ID:1][LEN][PAYLOAD:0 ...,  PAYLOAD:n] if LEN=0 then just [ID:0, ID:1][LEN]*/
-				pckt_inst->calc_crc_16_checksum = pckt_inst->conf.crc_16_fptr(pckt_inst->rx_buffer, (pckt_inst->rx_buffer_ind - 2)); //subtract 2 bytes for [CRC16:0, CRC16:1]
-
-				/*Copy received CRC checksum*/
-				pckt_inst->pckt_rx.crc_16_checksum = UNSERIALIZE_UINT16(pckt_inst->rx_buffer[CRC1_POS(pckt_inst->pckt_rx.len)], pckt_inst->rx_buffer[CRC0_POS(pckt_inst->pckt_rx.len)]);
-
-				/*Check if calculated checksum matches received*/
-				if(pckt_inst->calc_crc_16_checksum == pckt_inst->pckt_rx.crc_16_checksum)
-				{
-					/*Copy ID*/
-					pckt_inst->pckt_rx.id = UNSERIALIZE_UINT16(pckt_inst->rx_buffer[ID_1_POS], pckt_inst->rx_buffer[ID_0_POS]);
-
-					/*Copy data - if data in packet*/
-					if(pckt_inst->pckt_rx.len > 0)
-					{
-						for(i = 0; i < pckt_inst->pckt_rx.len; i++)
-						{
-							pckt_inst->pckt_rx.payload[i] = pckt_inst->rx_buffer[DATA_N_POS + i];
-						}
-					}
-					/*Fill with zeros*/
-					else
-					{
-						for(i = 0; i < pckt_inst->pckt_rx.len; i++)
-						{
-							pckt_inst->pckt_rx.payload[i] = 0;
-						}
-					}
-
-					/*Run command handler*/
-					cmd_handler_fptr(pckt_inst, pckt_inst->pckt_rx);
-				}
-				else
-				{
-					pckt_err_send(pckt_inst, PCKT_ERR_ID_CHKSM);
-				}
-
-				/*Clear buffer*/
-				pckt_inst->rx_buffer_ind = 0;
-			}
-		}
-	}
+	rx_feed(pckt_inst, data, len, &handler);
+}
 
-	/*Clear buffer timeout if timeout has expired and there is data in the buffer*/
-	if (tmrCheckReset(&pckt_inst->last_tick, pckt_inst->conf.clear_buffer_timeout) && (pckt_inst->rx_buffer_ind > 0))
-	{
-		/*Clear buffer*/
-		pckt_inst->rx_buffer_ind = 0;
+/******************************************************************************
+*  \brief Packet feed, zero copy
+*
+*  \note same as pckt_feed() but the handler gets a view of the packet in the
+*        receive buffer instead of a copy, see pckt_view_t for lifetime
+******************************************************************************/
+void pckt_feed_view(pckt_inst_t * const pckt_inst, const uint8_t * data, size_t len, void(*view_handler_fptr)(pckt_inst_t * const, const pckt_view_t * const))
+{
+	const rx_handler_t handler = {0, view_handler_fptr};
 
-		pckt_err_send(pckt_inst, PCKT_ERR_ID_TO);
-	}
+	rx_feed(pckt_inst, data, len, &handler);
 }
 
 /******************************************************************************
@@ -240,7 +332,7 @@ void pckt_task(pckt_inst_t * const pckt_inst, void(*cmd_handler_fptr)(pckt_inst_
 ******************************************************************************/
 void pckt_flush_rx(pckt_inst_t * const pckt_inst)
 {
-	pckt_inst->rx_buffer_ind = 0;
+	rx_clear(pckt_inst);
 }
 
 /******************************************************************************
@@ -250,11 +342,21 @@ void pckt_flush_rx(pckt_inst_t * const pckt_inst)
 *        CRC16_CCIT_ZERO
 *        CRC-16 (CRC-CCITT)
 *        Calculator: http://www.sunshine2k.de/coding/javascript/crc/crc_js.html
+*        Faster drop in replacements are in pckt_crc.h
 ******************************************************************************/
 crc_t pckt_sw_crc(const uint8_t * const message, const uint8_t num_bytes)
 {
-	crc_t remainder = 0;
-	uint8_t byte;
+	return pckt_sw_crc_update(0, message, num_bytes);
+}
+
+/******************************************************************************
+*  \brief Software CRC update (SLOW)
+*
+*  \note continues remainder over num_bytes of message, fits crc_16_update_fptr
+******************************************************************************/
+crc_t pckt_sw_crc_update(crc_t remainder, const uint8_t * message, uint16_t num_bytes)
+{
+	uint16_t byte;
 
 	/*Perform modulo-2 division, a byte at a time.*/
 	for(byte = 0; byte < num_bytes; ++byte)
@@ -281,42 +383,156 @@ crc_t pckt_sw_crc(const uint8_t * const message, const uint8_t num_bytes)
 	return remainder;
 }
 
+/******************************************************************************
+*  \brief Software CRC-32C update (SLOW)
+*
+*  \note CRC-32C (Castagnoli) used by ext_len frames, fits crc_32_update_fptr.
+*        Inverts in and out so updates chain, start with 0.
+*        "123456789" gives 0xE3069283. Faster replacements are in pckt_crc.h
+******************************************************************************/
+uint32_t pckt_sw_crc32c_update(uint32_t crc, const uint8_t * message, uint16_t num_bytes)
+{
+	uint16_t byte;
+
+	crc = ~crc;
+
+	for(byte = 0; byte < num_bytes; ++byte)
+	{
+		crc ^= message[byte];
+
+		for(uint8_t bit = 8; bit > 0; --bit)
+		{
+			crc = (crc & 1) ? ((crc >> 1) ^ CRC32C_POLYNOMIAL) : (crc >> 1);
+		}
+	}
+
+	return ~crc;
+}
+
+/******************************************************************************
+*  \brief Flush transmit batch
+*
+*  \note sends packets collected in tx_batch_buffer, one tx_vec_fptr call or
+*        tx_data_fprt calls of up to 255 bytes
+******************************************************************************/
+void pckt_flush_tx(pckt_inst_t * const pckt_inst)
+{
+	if(pckt_inst->tx_batch_len == 0) return;
+
+	tx_seg(pckt_inst, pckt_inst->conf.tx_batch_buffer, pckt_inst->tx_batch_len);
+
+	pckt_inst->tx_batch_len = 0;
+}
+
 /******************************************************************************
 *  \brief TX raw data
 *
 *  \note
 ******************************************************************************/
-void pckt_tx_raw(pckt_inst_t * const pckt_inst, const uint16_t id, const uint8_t * const data, uint8_t len)
+void pckt_tx_raw(pckt_inst_t * const pckt_inst, const uint16_t id, const uint8_t * const data, const uint16_t len)
+{
+	const pckt_tx_seg_t seg = {data, len};
+
+	pckt_tx_gather(pckt_inst, id, &seg, 1);
+}
+
+/******************************************************************************
+*  \brief TX gather
+*
+*  \note sends one packet whose payload is the segments one after the other,
+*        e.g. a layer header and the caller's data without copying them
+*        together first. Up to PCKT_TX_GATHER_MAX_SEGS segments
+******************************************************************************/
+void pckt_tx_gather(pckt_inst_t * const pckt_inst, const uint16_t id, const pckt_tx_seg_t * const segs, uint8_t num_segs)
 {
+	uint8_t pckt[RX_EXT_BUFFER_LEN_BYTES];
+	pckt_tx_seg_t payload[PCKT_TX_GATHER_MAX_SEGS];
+	const uint8_t overhead = pckt_inst->hdr_len + pckt_inst->crc_len;
+	uint16_t len = 0;
 	uint8_t i;
-	uint8_t pckt[RX_BUFFER_LEN_BYTES];
-	uint16_t checksum;
 
 	/*If packet is disabled do not run*/
 	if(pckt_inst->conf.enable == PCKT_DISABLED) return;
 
-	/*Limit len*/
-	len = (len > MAX_PAYLOAD_LEN_BYTES ? MAX_PAYLOAD_LEN_BYTES : len);
+	PROF_START(pckt_inst, PCKT_PROF_TX, prof_tx);
 
-	/*Copy data to holding array*/
-	pckt[ID_1_POS] = (uint8_t)(id >> 8);
-	pckt[ID_0_POS] = (uint8_t)id;
-	pckt[LEN_POS]  = len;
+	/*Limit segments and len*/
+	num_segs = (num_segs > PCKT_TX_GATHER_MAX_SEGS ? PCKT_TX_GATHER_MAX_SEGS : num_segs);
+
+	for(i = 0; i < num_segs; i++)
+	{
+		payload[i] = segs[i];
+
+		if(((uint32_t)len + payload[i].len) > pckt_inst->max_payload_len)
+		{
+			payload[i].len = pckt_inst->max_payload_len - len;
+		}
+
+		len += payload[i].len;
+	}
 
-	for(i = 0; i < len; i++)
+	STATS_ADD(pckt_inst, tx_frames, 1);
+	STATS_ADD(pckt_inst, tx_bytes, len + overhead);
+
+	/*Collect packet in batch*/
+	if((pckt_inst->conf.tx_batch_buffer != 0) && (((uint32_t)len + overhead) <= pckt_inst->conf.tx_batch_size))
 	{
-		pckt[DATA_N_POS + i] = data[i];
+		/*Make room*/
+		if(((uint32_t)pckt_inst->tx_batch_len + len + overhead) > pckt_inst->conf.tx_batch_size)
+		{
+			pckt_flush_tx(pckt_inst);
+		}
+
+		/*Batch timeout starts with the first packet*/
+		if(pckt_inst->tx_batch_len == 0)
+		{
+			pckt_inst->tx_batch_tick = pckt_get_tick(pckt_inst);
+		}
+
+		pckt_inst->tx_batch_len += tx_build(pckt_inst, &pckt_inst->conf.tx_batch_buffer[pckt_inst->tx_batch_len], id, payload, num_segs, len);
+
+		if(pckt_inst->tx_batch_len >= pckt_inst->conf.tx_batch_threshold)
+		{
+			pckt_flush_tx(pckt_inst);
+		}
+
+		PROF_END(pckt_inst, PCKT_PROF_TX, prof_tx);
+		return;
 	}
 
-	/*Calc checksum*/
-	checksum = pckt_inst->conf.crc_16_fptr(pckt, (len + 3));
+	/*Keep order with packets already in batch*/
+	pckt_flush_tx(pckt_inst);
 
-	/*Copy checksum*/
-	pckt[CRC1_POS(len)] = (uint8_t)(checksum >> 8);
-	pckt[CRC0_POS(len)] = (uint8_t)checksum;
+	/*TX header, payload and crc as segments without copying payload, also when packet is bigger than pckt*/
+	if((pckt_inst->conf.tx_vec_fptr != 0) || (((uint32_t)len + overhead) > sizeof(pckt)))
+	{
+		tx_vec(pckt_inst, id, payload, num_segs, len);
+		PROF_END(pckt_inst, PCKT_PROF_TX, prof_tx);
+		return;
+	}
 
 	/*TX packet*/
-	pckt_inst->conf.tx_data_fprt(pckt, len + 5);
+	tx_data(pckt_inst, pckt, tx_build(pckt_inst, pckt, id, payload, num_segs, len));
+	PROF_END(pckt_inst, PCKT_PROF_TX, prof_tx);
+}
+
+/******************************************************************************
+*  \brief Add receive hook
+*
+*  \note hooks run in the order added for every valid packet, before the
+*        command handler. Used by the optional layers, e.g. pckt_frag_attach()
+******************************************************************************/
+void pckt_rx_hook_add(pckt_inst_t * const pckt_inst, pckt_rx_hook_t * const hook)
+{
+	pckt_rx_hook_t **last = &pckt_inst->rx_hook;
+
+	while(*last != 0)
+	{
+		last = &(*last)->next;
+	}
+
+	hook->next = 0;
+	*last = hook;
 }
 
 /******************************************************************************
@@ -352,7 +568,7 @@ void pckt_tx_u16(pckt_inst_t * const pckt_inst, const uint16_t id, const uint16_
 {
     uint8_t pckt[sizeof(data)];
 
-    sr_16(pckt, data);
+	pckt_sr_u16(pckt, data);
 	pckt_tx_raw(pckt_inst, id, pckt, sizeof(data));
 }
 
@@ -364,11 +580,8 @@ void pckt_tx_u16(pckt_inst_t * const pckt_inst, const uint16_t id, const uint16_
 void pckt_tx_s16(pckt_inst_t * const pckt_inst, const uint16_t id, const int16_t data)
 {
     uint8_t pckt[sizeof(data)];
-    bit16_dat_t bit16_dat;
-
-    bit16_dat._int = data;
 
-    sr_16(pckt, bit16_dat._uint);
+	pckt_sr_s16(pckt, data);
 	pckt_tx_raw(pckt_inst, id, pckt, sizeof(data));
 }
 
@@ -381,7 +594,7 @@ void pckt_tx_u32(pckt_inst_t * const pckt_inst, const uint16_t id, const uint32_
 {
     uint8_t pckt[sizeof(data)];
 
-    sr_32(pckt, data);
+	pckt_sr_u32(pckt, data);
 	pckt_tx_raw(pckt_inst, id, pckt, sizeof(data));
 }
 
@@ -393,11 +606,8 @@ void pckt_tx_u32(pckt_inst_t * const pckt_inst, const uint16_t id, const uint32_
 void pckt_tx_s32(pckt_inst_t * const pckt_inst, const uint16_t id, const int32_t data)
 {
     uint8_t pckt[sizeof(data)];
-    bit32_dat_t bit32_dat;
 
-    bit32_dat._int = data;
-
-    sr_32(pckt, bit32_dat._uint);
+	pckt_sr_s32(pckt, data);
 	pckt_tx_raw(pckt_inst, id, pckt, sizeof(data));
 }
 
@@ -409,11 +619,8 @@ void pckt_tx_s32(pckt_inst_t * const pckt_inst, const uint16_t id, const int32_t
 void pckt_tx_flt32(pckt_inst_t * const pckt_inst, const uint16_t id, const float data)
 {
     uint8_t pckt[sizeof(data)];
-    bit32_dat_t bit32_dat;
-
-    bit32_dat._flt = data;
 
-    sr_32(pckt, bit32_dat._uint);
+	pckt_sr_flt32(pckt, data);
 	pckt_tx_raw(pckt_inst, id, pckt, sizeof(data));
 }
 
@@ -426,7 +633,7 @@ void pckt_tx_u64(pckt_inst_t * const pckt_inst, const uint16_t id, const uint64_
 {
     uint8_t pckt[sizeof(data)];
 
-    sr_64(pckt, data);
+	pckt_sr_u64(pckt, data);
 	pckt_tx_raw(pckt_inst, id, pckt, sizeof(data));
 }
 
@@ -438,11 +645,8 @@ void pckt_tx_u64(pckt_inst_t * const pckt_inst, const uint16_t id, const uint64_
 void pckt_tx_s64(pckt_inst_t * const pckt_inst, const uint16_t id, const int64_t data)
 {
     uint8_t pckt[sizeof(data)];
-    bit64_dat_t bit64_dat;
 
-    bit64_dat._int = data;
-
-    sr_64(pckt, bit64_dat._uint);
+	pckt_sr_s64(pckt, data);
 	pckt_tx_raw(pckt_inst, id, pckt, sizeof(data));
 }
 
@@ -454,24 +658,215 @@ void pckt_tx_s64(pckt_inst_t * const pckt_inst, const uint16_t id, const int64_t
 void pckt_tx_dbl64(pckt_inst_t * const pckt_inst, const uint16_t id, const double data)
 {
     uint8_t pckt[sizeof(data)];
-    bit64_dat_t bit64_dat;
-
-    bit64_dat._dbl = data;
 
-    sr_64(pckt, bit64_dat._uint);
+	pckt_sr_dbl64(pckt, data);
 	pckt_tx_raw(pckt_inst, id, pckt, sizeof(data));
 }
 
+/******************************************************************************
+*  \brief TX unsigned 16BIT array
+*
+*  \note sends up to max_payload_len worth of count values
+******************************************************************************/
+void pckt_tx_u16_array(pckt_inst_t * const pckt_inst, const uint16_t id, const uint16_t * const data, const uint16_t count)
+{
+	tx_array(pckt_inst, id, data, count, sizeof(*data));
+}
+
+/******************************************************************************
+*  \brief TX signed 16BIT array
+*
+*  \note sends up to max_payload_len worth of count values
+******************************************************************************/
+void pckt_tx_s16_array(pckt_inst_t * const pckt_inst, const uint16_t id, const int16_t * const data, const uint16_t count)
+{
+	tx_array(pckt_inst, id, data, count, sizeof(*data));
+}
+
+/******************************************************************************
+*  \brief TX unsigned 32BIT array
+*
+*  \note sends up to max_payload_len worth of count values
+******************************************************************************/
+void pckt_tx_u32_array(pckt_inst_t * const pckt_inst, const uint16_t id, const uint32_t * const data, const uint16_t count)
+{
+	tx_array(pckt_inst, id, data, count, sizeof(*data));
+}
+
+/******************************************************************************
+*  \brief TX signed 32BIT array
+*
+*  \note sends up to max_payload_len worth of count values
+******************************************************************************/
+void pckt_tx_s32_array(pckt_inst_t * const pckt_inst, const uint16_t id, const int32_t * const data, const uint16_t count)
+{
+	tx_array(pckt_inst, id, data, count, sizeof(*data));
+}
+
+/******************************************************************************
+*  \brief TX float 32BIT array
+*
+*  \note sends up to max_payload_len worth of count values
+******************************************************************************/
+void pckt_tx_flt32_array(pckt_inst_t * const pckt_inst, const uint16_t id, const float * const data, const uint16_t count)
+{
+	tx_array(pckt_inst, id, data, count, sizeof(*data));
+}
+
+/******************************************************************************
+*  \brief TX unsigned 64BIT array
+*
+*  \note sends up to max_payload_len worth of count values
+******************************************************************************/
+void pckt_tx_u64_array(pckt_inst_t * const pckt_inst, const uint16_t id, const uint64_t * const data, const uint16_t count)
+{
+	tx_array(pckt_inst, id, data, count, sizeof(*data));
+}
+
+/******************************************************************************
+*  \brief TX signed 64BIT array
+*
+*  \note sends up to max_payload_len worth of count values
+******************************************************************************/
+void pckt_tx_s64_array(pckt_inst_t * const pckt_inst, const uint16_t id, const int64_t * const data, const uint16_t count)
+{
+	tx_array(pckt_inst, id, data, count, sizeof(*data));
+}
+
+/******************************************************************************
+*  \brief TX double 64BIT array
+*
+*  \note sends up to max_payload_len worth of count values
+******************************************************************************/
+void pckt_tx_dbl64_array(pckt_inst_t * const pckt_inst, const uint16_t id, const double * const data, const uint16_t count)
+{
+	tx_array(pckt_inst, id, data, count, sizeof(*data));
+}
+
 /******************************************************************************
 *  \brief Packet enable disable
 *
-*  \note disables or enables packet task and packet_tx_raw
+*  \note disables or enables packet task and packet_tx_raw, an instance
+*        without a receive buffer stays disabled
 ******************************************************************************/
 void pckt_enable(pckt_inst_t * const pckt_inst, const pckt_en_t enable)
 {
+	if(pckt_inst->rx_buffer == 0) return;
+
 	pckt_inst->conf.enable = enable;
 }
 
+/******************************************************************************
+*  \brief Packet statistics get
+*
+*  \note copies the instance counters to stats, all zero with PCKT_STATS_EN=0.
+*        Not atomic, counters updated from an interrupt may change mid copy
+******************************************************************************/
+void pckt_stats_get(const pckt_inst_t * const pckt_inst, pckt_stats_t * const stats)
+{
+#if PCKT_STATS_EN
+	*stats = pckt_inst->stats;
+#else
+	(void)pckt_inst;
+	memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+/******************************************************************************
+*  \brief Packet statistics reset
+*
+*  \note
+******************************************************************************/
+void pckt_stats_reset(pckt_inst_t * const pckt_inst)
+{
+#if PCKT_STATS_EN
+	memset(&pckt_inst->stats, 0, sizeof(pckt_inst->stats));
+#else
+	(void)pckt_inst;
+#endif
+}
+
+/******************************************************************************
+*  \brief Packet get tick
+*
+*  \note reads the clock of the instance, tick_fptr or tick_ptr. Layers use it
+*        so they run on the same clock as their instance
+******************************************************************************/
+TICK_TYPE pckt_get_tick(const pckt_inst_t * const pckt_inst)
+{
+	if(pckt_inst->conf.tick_fptr != 0) return pckt_inst->conf.tick_fptr();
+
+#if !PCKT_TICK_GLOBAL_EN
+	if(pckt_inst->conf.tick_ptr == 0) return 0;
+#endif
+
+	return *pckt_inst->conf.tick_ptr;
+}
+
+/******************************************************************************
+*  \brief Packet tick elapsed
+*
+*  \note returns the ticks since a pckt_get_tick() value, correct across
+*        wraps of the clock
+******************************************************************************/
+TICK_TYPE pckt_tick_elapsed(const pckt_inst_t * const pckt_inst, const TICK_TYPE since)
+{
+	return (TICK_TYPE)(pckt_get_tick(pckt_inst) - since);
+}
+
+/******************************************************************************
+*  \brief Packet next deadline
+*
+*  \note returns 1 and the tick pckt_task() next has timed work at, or 0 if
+*        it has none until data arrives. Covers the rx timeout of a partial
+*        packet, tx batch timeout and deferred and summary error replies, so
+*        an event loop can sleep until data or deadline. Layer timeouts, e.g.
+*        pckt_rel_task(), are not included
+******************************************************************************/
+uint8_t pckt_next_deadline(const pckt_inst_t * const pckt_inst, TICK_TYPE * const deadline)
+{
+	const TICK_TYPE now = pckt_get_tick(pckt_inst);
+	TICK_TYPE remain = 0;
+	uint8_t found = 0;
+	uint8_t ind;
+
+	if(pckt_inst->rx_buffer_ind > pckt_inst->rx_buffer_start)
+	{
+		tick_remain(now, pckt_inst->last_tick, pckt_inst->conf.clear_buffer_timeout, &remain, &found);
+	}
+
+	if(pckt_inst->tx_batch_len > 0)
+	{
+		tick_remain(now, pckt_inst->tx_batch_tick, pckt_inst->conf.tx_batch_timeout, &remain, &found);
+	}
+
+	if(pckt_inst->conf.err_rply == PCKT_ERR_RPLY_DEFERRED)
+	{
+		for(ind = 0; ind < PCKT_ERR_TYPES; ind++)
+		{
+			if((pckt_inst->err_pend & (1 << ind)) == 0) continue;
+
+			/*Due now unless held back by err_rply_interval*/
+			if(pckt_inst->err_sent & (1 << ind))
+			{
+				tick_remain(now, pckt_inst->err_tick[ind], pckt_inst->conf.err_rply_interval[ind], &remain, &found);
+			}
+			else
+			{
+				tick_remain(now, now, 0, &remain, &found);
+			}
+		}
+	}
+	else if((pckt_inst->conf.err_rply == PCKT_ERR_RPLY_SUMMARY) && (pckt_inst->err_pend != 0))
+	{
+		tick_remain(now, pckt_inst->err_summary_tick, pckt_inst->conf.err_summary_period, &remain, &found);
+	}
+
+	if(found) *deadline = (TICK_TYPE)(now + remain);
+
+	return found;
+}
+
 /******************************************************************************
 *  \brief Packet payload convert to uint8
 *
@@ -479,13 +874,13 @@ void pckt_enable(pckt_inst_t * const pckt_inst, const pckt_en_t enable)
 ******************************************************************************/
 pckt_rx_valid_t pckt_rx_u8(pckt_inst_t * const pckt_inst, uint8_t * const dest)
 {
-	if(sizeof(*dest) != pckt_inst->pckt_rx.len)
+	if(sizeof(*dest) != pckt_inst->rx_view.len)
 	{
 		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
 		return PCKT_INVALID_LEN;
 	}
 
-	*dest = pckt_inst->pckt_rx.payload[0];
+	*dest = pckt_inst->rx_view.payload[0];
 
 	return PCKT_VALID_LEN;
 }
@@ -499,13 +894,13 @@ pckt_rx_valid_t pckt_rx_s8(pckt_inst_t * const pckt_inst, int8_t * const dest)
 {
     bit8_dat_t bit8_dat;
 
-	if(sizeof(*dest) != pckt_inst->pckt_rx.len)
+	if(sizeof(*dest) != pckt_inst->rx_view.len)
 	{
 		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
 		return PCKT_INVALID_LEN;
 	}
 
-    bit8_dat._uint = pckt_inst->pckt_rx.payload[0];
+    bit8_dat._uint = pckt_inst->rx_view.payload[0];
 
 	*dest = bit8_dat._int;
 
@@ -519,17 +914,13 @@ pckt_rx_valid_t pckt_rx_s8(pckt_inst_t * const pckt_inst, int8_t * const dest)
 ******************************************************************************/
 pckt_rx_valid_t pckt_rx_u16(pckt_inst_t * const pckt_inst, uint16_t * const dest)
 {
-    bit16_dat_t bit16_dat;
-
-	if(sizeof(*dest) != pckt_inst->pckt_rx.len)
+	if(sizeof(*dest) != pckt_inst->rx_view.len)
 	{
 		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
 		return PCKT_INVALID_LEN;
 	}
 
-    bit16_dat = unsr_16(pckt_inst->pckt_rx.payload);
-
-	*dest = bit16_dat._uint;
+	*dest = pckt_unsr_u16(pckt_inst->rx_view.payload);
 
 	return PCKT_VALID_LEN;
 }
@@ -541,17 +932,13 @@ pckt_rx_valid_t pckt_rx_u16(pckt_inst_t * const pckt_inst, uint16_t * const dest
 ******************************************************************************/
 pckt_rx_valid_t pckt_rx_s16(pckt_inst_t * const pckt_inst, int16_t * const dest)
 {
-    bit16_dat_t bit16_dat;
-
-	if(sizeof(*dest) != pckt_inst->pckt_rx.len)
+	if(sizeof(*dest) != pckt_inst->rx_view.len)
 	{
 		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
 		return PCKT_INVALID_LEN;
 	}
 
-    bit16_dat = unsr_16(pckt_inst->pckt_rx.payload);
-
-	*dest = bit16_dat._int;
+	*dest = pckt_unsr_s16(pckt_inst->rx_view.payload);
 
 	return PCKT_VALID_LEN;
 }
@@ -563,17 +950,13 @@ pckt_rx_valid_t pckt_rx_s16(pckt_inst_t * const pckt_inst, int16_t * const dest)
 ******************************************************************************/
 pckt_rx_valid_t pckt_rx_u32(pckt_inst_t * const pckt_inst, uint32_t * const dest)
 {
-	bit32_dat_t bit32_dat;
-
-	if(sizeof(*dest) != pckt_inst->pckt_rx.len)
+	if(sizeof(*dest) != pckt_inst->rx_view.len)
 	{
 		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
 		return PCKT_INVALID_LEN;
 	}
 
-    bit32_dat = unsr_32(pckt_inst->pckt_rx.payload);
-
-	*dest = bit32_dat._uint;
+	*dest = pckt_unsr_u32(pckt_inst->rx_view.payload);
 
 	return PCKT_VALID_LEN;
 }
@@ -585,17 +968,13 @@ pckt_rx_valid_t pckt_rx_u32(pckt_inst_t * const pckt_inst, uint32_t * const dest
 ******************************************************************************/
 pckt_rx_valid_t pckt_rx_s32(pckt_inst_t * const pckt_inst, int32_t * const dest)
 {
-	bit32_dat_t bit32_dat;
-
-	if(sizeof(*dest) != pckt_inst->pckt_rx.len)
+	if(sizeof(*dest) != pckt_inst->rx_view.len)
 	{
 		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
 		return PCKT_INVALID_LEN;
 	}
 
-    bit32_dat = unsr_32(pckt_inst->pckt_rx.payload);
-
-	*dest = bit32_dat._int;
+	*dest = pckt_unsr_s32(pckt_inst->rx_view.payload);
 
 	return PCKT_VALID_LEN;
 }
@@ -607,17 +986,13 @@ pckt_rx_valid_t pckt_rx_s32(pckt_inst_t * const pckt_inst, int32_t * const dest)
 ******************************************************************************/
 pckt_rx_valid_t pckt_rx_flt32(pckt_inst_t * const pckt_inst, float * const dest)
 {
-	bit32_dat_t bit32_dat;
-
-	if(sizeof(*dest) != pckt_inst->pckt_rx.len)
+	if(sizeof(*dest) != pckt_inst->rx_view.len)
 	{
 		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
 		return PCKT_INVALID_LEN;
 	}
 
-    bit32_dat = unsr_32(pckt_inst->pckt_rx.payload);
-
-	*dest = bit32_dat._flt;
+	*dest = pckt_unsr_flt32(pckt_inst->rx_view.payload);
 
 	return PCKT_VALID_LEN;
 }
@@ -629,17 +1004,13 @@ pckt_rx_valid_t pckt_rx_flt32(pckt_inst_t * const pckt_inst, float * const dest)
 ******************************************************************************/
 pckt_rx_valid_t pckt_rx_u64(pckt_inst_t * const pckt_inst, uint64_t * const dest)
 {
-	bit64_dat_t bit64_dat;
-
-	if(sizeof(*dest) != pckt_inst->pckt_rx.len)
+	if(sizeof(*dest) != pckt_inst->rx_view.len)
 	{
 		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
 		return PCKT_INVALID_LEN;
 	}
 
-    bit64_dat = unsr_64(pckt_inst->pckt_rx.payload);
-
-	*dest = bit64_dat._uint;
+	*dest = pckt_unsr_u64(pckt_inst->rx_view.payload);
 
 	return PCKT_VALID_LEN;
 }
@@ -651,17 +1022,13 @@ pckt_rx_valid_t pckt_rx_u64(pckt_inst_t * const pckt_inst, uint64_t * const dest
 ******************************************************************************/
 pckt_rx_valid_t pckt_rx_s64(pckt_inst_t * const pckt_inst, int64_t * const dest)
 {
-	bit64_dat_t bit64_dat;
-
-	if(sizeof(*dest) != pckt_inst->pckt_rx.len)
+	if(sizeof(*dest) != pckt_inst->rx_view.len)
 	{
 		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
 		return PCKT_INVALID_LEN;
 	}
 
-    bit64_dat = unsr_64(pckt_inst->pckt_rx.payload);
-
-	*dest = bit64_dat._int;
+	*dest = pckt_unsr_s64(pckt_inst->rx_view.payload);
 
 	return PCKT_VALID_LEN;
 }
@@ -673,48 +1040,267 @@ pckt_rx_valid_t pckt_rx_s64(pckt_inst_t * const pckt_inst, int64_t * const dest)
 ******************************************************************************/
 pckt_rx_valid_t pckt_rx_dbl64(pckt_inst_t * const pckt_inst, double * const dest)
 {
-	bit64_dat_t bit64_dat;
-
-	if(sizeof(*dest) != pckt_inst->pckt_rx.len)
+	if(sizeof(*dest) != pckt_inst->rx_view.len)
 	{
 		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
 		return PCKT_INVALID_LEN;
 	}
 
-    bit64_dat = unsr_64(pckt_inst->pckt_rx.payload);
-
-	*dest = bit64_dat._dbl;
+	*dest = pckt_unsr_dbl64(pckt_inst->rx_view.payload);
 
 	return PCKT_VALID_LEN;
 }
 
+/******************************************************************************
+*  \brief Packet payload convert to uint16 array
+*
+*  \note payload must be a whole number of values and fit max_count
+******************************************************************************/
+pckt_rx_valid_t pckt_rx_u16_array(pckt_inst_t * const pckt_inst, uint16_t * const dest, const uint16_t max_count, uint16_t * const count)
+{
+	return rx_array(pckt_inst, dest, sizeof(*dest), max_count, count);
+}
+
+/******************************************************************************
+*  \brief Packet payload convert to int16 array
+*
+*  \note payload must be a whole number of values and fit max_count
+******************************************************************************/
+pckt_rx_valid_t pckt_rx_s16_array(pckt_inst_t * const pckt_inst, int16_t * const dest, const uint16_t max_count, uint16_t * const count)
+{
+	return rx_array(pckt_inst, dest, sizeof(*dest), max_count, count);
+}
+
+/******************************************************************************
+*  \brief Packet payload convert to uint32 array
+*
+*  \note payload must be a whole number of values and fit max_count
+******************************************************************************/
+pckt_rx_valid_t pckt_rx_u32_array(pckt_inst_t * const pckt_inst, uint32_t * const dest, const uint16_t max_count, uint16_t * const count)
+{
+	return rx_array(pckt_inst, dest, sizeof(*dest), max_count, count);
+}
+
+/******************************************************************************
+*  \brief Packet payload convert to int32 array
+*
+*  \note payload must be a whole number of values and fit max_count
+******************************************************************************/
+pckt_rx_valid_t pckt_rx_s32_array(pckt_inst_t * const pckt_inst, int32_t * const dest, const uint16_t max_count, uint16_t * const count)
+{
+	return rx_array(pckt_inst, dest, sizeof(*dest), max_count, count);
+}
+
+/******************************************************************************
+*  \brief Packet payload convert to float array
+*
+*  \note payload must be a whole number of values and fit max_count
+******************************************************************************/
+pckt_rx_valid_t pckt_rx_flt32_array(pckt_inst_t * const pckt_inst, float * const dest, const uint16_t max_count, uint16_t * const count)
+{
+	return rx_array(pckt_inst, dest, sizeof(*dest), max_count, count);
+}
+
+/******************************************************************************
+*  \brief Packet payload convert to uint64 array
+*
+*  \note payload must be a whole number of values and fit max_count
+******************************************************************************/
+pckt_rx_valid_t pckt_rx_u64_array(pckt_inst_t * const pckt_inst, uint64_t * const dest, const uint16_t max_count, uint16_t * const count)
+{
+	return rx_array(pckt_inst, dest, sizeof(*dest), max_count, count);
+}
+
+/******************************************************************************
+*  \brief Packet payload convert to int64 array
+*
+*  \note payload must be a whole number of values and fit max_count
+******************************************************************************/
+pckt_rx_valid_t pckt_rx_s64_array(pckt_inst_t * const pckt_inst, int64_t * const dest, const uint16_t max_count, uint16_t * const count)
+{
+	return rx_array(pckt_inst, dest, sizeof(*dest), max_count, count);
+}
+
+/******************************************************************************
+*  \brief Packet payload convert to double array
+*
+*  \note payload must be a whole number of values and fit max_count
+******************************************************************************/
+pckt_rx_valid_t pckt_rx_dbl64_array(pckt_inst_t * const pckt_inst, double * const dest, const uint16_t max_count, uint16_t * const count)
+{
+	return rx_array(pckt_inst, dest, sizeof(*dest), max_count, count);
+}
+
 /******************************************************************************
 *  \brief Error send
 *
-*  \note
+*  \note CHKSM, TO, RX_LEN and UKN_ID follow conf.err_rply and
+*        err_rply_interval, ACK and NACK are sent unless err_rply is disabled
 ******************************************************************************/
 void pckt_err_send(pckt_inst_t * const pckt_inst, const pckt_err_id_t error)
 {
-	if(pckt_inst->conf.err_rply == PCKT_DISABLED) return; //Do not transmit error
-	
+	uint8_t ind;
+
+	/*Count error, also when it is not sent*/
+	switch(error)
+	{
+		case PCKT_ERR_ID_CHKSM:  STATS_ADD(pckt_inst, rx_crc_err, 1); break;
+		case PCKT_ERR_ID_TO:     STATS_ADD(pckt_inst, rx_timeout, 1); break;
+		case PCKT_ERR_ID_RX_LEN: STATS_ADD(pckt_inst, rx_len_err, 1); break;
+		case PCKT_ERR_ID_UKN_ID: STATS_ADD(pckt_inst, rx_ukn_id, 1);  break;
+		default: break;
+	}
+
+	if(pckt_inst->conf.err_rply == PCKT_ERR_RPLY_DISABLED) return; //Do not transmit error
+
+	/*Only the PCKT_ERR_TYPES errors are under the policy*/
 	switch(error)
 	{
-		//zero byte payload
 		case PCKT_ERR_ID_CHKSM:
 		case PCKT_ERR_ID_TO:
-		case PCKT_ERR_ID_ACK:
-		case PCKT_ERR_ID_NACK:
-			pckt_tx_raw(pckt_inst, (uint16_t)error, 0, 0);
-			break;
-
-		//offending ID as payload
 		case PCKT_ERR_ID_RX_LEN:
 		case PCKT_ERR_ID_UKN_ID:
-			pckt_tx_u16(pckt_inst, error, pckt_inst->pckt_rx.id);
+			ind = (uint8_t)PCKT_ERR_IND(error);
+			break;
+
+		default:
+			err_tx(pckt_inst, error, pckt_inst->rx_view.id);
+			return;
+	}
+
+	switch(pckt_inst->conf.err_rply)
+	{
+		case PCKT_ERR_RPLY_IMMEDIATE:
+			if(err_ready(pckt_inst, ind))
+			{
+				err_tx(pckt_inst, error, pckt_inst->rx_view.id);
+			}
+			else
+			{
+				STATS_ADD(pckt_inst, err_rply_dropped, 1);
+			}
+			break;
+
+		case PCKT_ERR_RPLY_DEFERRED:
+			/*Replaces one still waiting*/
+			if(pckt_inst->err_pend & (1 << ind))
+			{
+				STATS_ADD(pckt_inst, err_rply_dropped, 1);
+			}
+
+			pckt_inst->err_pend        |= (uint8_t)(1 << ind);
+			pckt_inst->err_pend_id[ind] = pckt_inst->rx_view.id;
+			break;
+
+		case PCKT_ERR_RPLY_SUMMARY:
+			if(pckt_inst->err_count[ind] < UINT16_MAX)
+			{
+				pckt_inst->err_count[ind]++;
+			}
+
+			pckt_inst->err_pend |= (uint8_t)(1 << ind);
+			break;
+
+		default:
+			break;
+	}
+}
+
+/******************************************************************************
+*  \brief Serialize array, big endian
+*
+*  \note count values of width bytes (2, 4 or 8) from host memory to dest,
+*        whole 16 byte vectors with SSE2 or NEON, see PCKT_SIMD_EN
+******************************************************************************/
+void pckt_sr_array(uint8_t * const dest, const void * const src, const uint16_t count, const uint8_t width)
+{
+	const uint8_t * const src_bytes = (const uint8_t *)src;
+	const uint16_t num_bytes = count * width;
+	uint16_t i = bswap_simd(dest, src_bytes, num_bytes, width);
+	uint16_t u16;
+	uint32_t u32;
+	uint64_t u64;
+
+	/*Values after the whole vectors*/
+	switch(width)
+	{
+		case sizeof(u16):
+			for(; i < num_bytes; i += sizeof(u16))
+			{
+				memcpy(&u16, &src_bytes[i], sizeof(u16));
+				pckt_sr_u16(&dest[i], u16);
+			}
+			break;
+
+		case sizeof(u32):
+			for(; i < num_bytes; i += sizeof(u32))
+			{
+				memcpy(&u32, &src_bytes[i], sizeof(u32));
+				pckt_sr_u32(&dest[i], u32);
+			}
+			break;
+
+		case sizeof(u64):
+			for(; i < num_bytes; i += sizeof(u64))
+			{
+				memcpy(&u64, &src_bytes[i], sizeof(u64));
+				pckt_sr_u64(&dest[i], u64);
+			}
+			break;
+
+		default:
+			memcpy(dest, src, num_bytes);
 			break;
 	}
 }
 
+/******************************************************************************
+*  \brief Unserialize array
+*
+*  \note count big endian values of width bytes (2, 4 or 8) from src to host
+*        memory, whole 16 byte vectors with SSE2 or NEON, see PCKT_SIMD_EN
+******************************************************************************/
+void pckt_unsr_array(void * const dest, const uint8_t * const src, const uint16_t count, const uint8_t width)
+{
+	uint8_t * const dest_bytes = (uint8_t *)dest;
+	const uint16_t num_bytes = count * width;
+	uint16_t i = bswap_simd(dest_bytes, src, num_bytes, width);
+	uint16_t u16;
+	uint32_t u32;
+	uint64_t u64;
+
+	/*Values after the whole vectors*/
+	switch(width)
+	{
+		case sizeof(u16):
+			for(; i < num_bytes; i += sizeof(u16))
+			{
+				u16 = pckt_unsr_u16(&src[i]);
+				memcpy(&dest_bytes[i], &u16, sizeof(u16));
+			}
+			break;
+
+		case sizeof(u32):
+			for(; i < num_bytes; i += sizeof(u32))
+			{
+				u32 = pckt_unsr_u32(&src[i]);
+				memcpy(&dest_bytes[i], &u32, sizeof(u32));
+			}
+			break;
+
+		case sizeof(u64):
+			for(; i < num_bytes; i += sizeof(u64))
+			{
+				u64 = pckt_unsr_u64(&src[i]);
+				memcpy(&dest_bytes[i], &u64, sizeof(u64));
+			}
+			break;
+
+		default:
+			memcpy(dest, src, num_bytes);
+			break;
+	}
+}
 
 /**************************************************************************************************
 *                                         LOCAL FUNCTIONS
@@ -730,110 +1316,931 @@ static int16_t dflt_rx_byte(void)
 }
 
 /******************************************************************************
-*  \brief Default tx data function
+*  \brief RX task
 *
-*  \note
+*  \note reads received bytes and handles timeout, see pckt_task()
 ******************************************************************************/
-static void dflt_tx_data(const uint8_t * const data, const uint8_t length)
+static void rx_task(pckt_inst_t * const pckt_inst, const rx_handler_t * const handler)
 {
-	//empty
+	uint8_t rx_block[PCKT_RX_BLOCK_LEN_BYTES];
+	uint16_t rx_len;
+
+	/*If packet is disabled do not run*/
+	if(pckt_inst->conf.enable == PCKT_DISABLED) return;
+
+	/*Get bytes*/
+	if(pckt_inst->conf.rx_block_fptr != 0)
+	{
+		PROF_START(pckt_inst, PCKT_PROF_RX_READ, prof_read);
+		rx_len = pckt_inst->conf.rx_block_fptr(rx_block, sizeof(rx_block));
+		PROF_END(pckt_inst, PCKT_PROF_RX_READ, prof_read);
+
+		if(rx_len > 0)
+		{
+			rx_feed(pckt_inst, rx_block, rx_len, handler);
+		}
+	}
+	else
+	{
+		PROF_START(pckt_inst, PCKT_PROF_RX_READ, prof_read);
+		pckt_inst->rx_byte = pckt_inst->conf.rx_byte_fptr();
+		PROF_END(pckt_inst, PCKT_PROF_RX_READ, prof_read);
+
+		/*Check for received byte*/
+		if(pckt_inst->rx_byte != -1)
+		{
+			rx_block[0] = (uint8_t)pckt_inst->rx_byte;
+			rx_feed(pckt_inst, rx_block, 1, handler);
+		}
+	}
+
+	/*Send batch once its first packet is old enough*/
+	if((pckt_inst->tx_batch_len > 0) && (pckt_tick_elapsed(pckt_inst, pckt_inst->tx_batch_tick) >= pckt_inst->conf.tx_batch_timeout))
+	{
+		pckt_flush_tx(pckt_inst);
+	}
+
+	/*Clear buffer timeout, armed only while there is data in the buffer so an empty one never reads the clock*/
+	if((pckt_inst->rx_buffer_ind > pckt_inst->rx_buffer_start) && (pckt_tick_elapsed(pckt_inst, pckt_inst->last_tick) >= pckt_inst->conf.clear_buffer_timeout))
+	{
+		pckt_err_send(pckt_inst, PCKT_ERR_ID_TO);
+
+		if(pckt_inst->conf.resync == PCKT_ENABLED)
+		{
+			/*A bad header whose LEN never arrives can hold complete packets behind it, slide to them instead of
+			 *dropping them. Every partial packet left is as old as the timeout, so this ends with an empty buffer*/
+			pckt_inst->rx_resyncing = 1;
+
+			while(pckt_inst->rx_buffer_ind > pckt_inst->rx_buffer_start)
+			{
+				STATS_ADD(pckt_inst, rx_resync_bytes, 1);
+				rx_drop(pckt_inst, 1);
+				rx_scan(pckt_inst, handler);
+			}
+		}
+
+		/*Clear buffer*/
+		rx_clear(pckt_inst);
+		pckt_inst->rx_resyncing = 0;
+	}
+
+	/*Deferred and summary error replies*/
+	if(pckt_inst->conf.err_rply >= PCKT_ERR_RPLY_DEFERRED)
+	{
+		err_task(pckt_inst);
+	}
 }
 
 /******************************************************************************
-*  \brief Unserialize 16bit
+*  \brief RX feed
 *
-*  \note
+*  \note parses a block of received bytes, see pckt_feed()
 ******************************************************************************/
-static bit16_dat_t unsr_16(const uint8_t * const big_endian_data)
+static void rx_feed(pckt_inst_t * const pckt_inst, const uint8_t * data, size_t len, const rx_handler_t * const handler)
 {
-    uint8_t i;
-    bit16_dat_t bit16_dat = {0};
+	uint16_t cpy_len;
+
+	/*If packet is disabled do not run*/
+	if(pckt_inst->conf.enable == PCKT_DISABLED) return;
+
+	if(len == 0) return;
+
+	STATS_ADD(pckt_inst, rx_bytes, len);
+
+	while(len > 0)
+	{
+		/*Move bytes left over from a resync to the start of the buffer*/
+		if(pckt_inst->rx_buffer_start > 0)
+		{
+			rx_compact(pckt_inst);
+		}
+
+		/*Put as many received bytes in buffer as the packet needs - [ID:0, ID:1][LEN] first, then the rest once LEN is known*/
+		cpy_len = ((pckt_inst->rx_buffer_ind < pckt_inst->hdr_len) ? pckt_inst->hdr_len : rx_frame_len(pckt_inst)) - pckt_inst->rx_buffer_ind;
+		if(cpy_len > len) cpy_len = (uint16_t)len;
+
+		PROF_START(pckt_inst, PCKT_PROF_RX_APPEND, prof_append);
+		memcpy(&pckt_inst->rx_buffer[pckt_inst->rx_buffer_ind], data, cpy_len);
+		PROF_END(pckt_inst, PCKT_PROF_RX_APPEND, prof_append);
+		pckt_inst->rx_buffer_ind += cpy_len;
+		data += cpy_len;
+		len  -= cpy_len;
 
-    for(i = 0; i < sizeof(bit16_dat); i++)
-    {
-        bit16_dat._uint |= ((uint16_t)big_endian_data[i] << (sizeof(bit16_dat) - 1 - i) * 8);
-    }
+		rx_scan(pckt_inst, handler);
+	}
 
-    return bit16_dat;
+	/*Arm the rx timeout only while a partial packet is buffered, from its last byte*/
+	if(pckt_inst->rx_buffer_ind > pckt_inst->rx_buffer_start)
+	{
+		pckt_inst->last_tick = pckt_get_tick(pckt_inst);
+	}
 }
 
 /******************************************************************************
-*  \brief Unserialize 32bit
+*  \brief RX scan
 *
-*  \note
+*  \note handles every complete packet at the start of the buffer, with resync
+*        enabled also slides past impossible LEN bytes
 ******************************************************************************/
-static bit32_dat_t unsr_32(const uint8_t * const big_endian_data)
+static void rx_scan(pckt_inst_t * const pckt_inst, const rx_handler_t * const handler)
 {
-    uint8_t i;
-    bit32_dat_t bit32_dat = {0};
+	/*After ID:0 ID:1 and LEN bytes received*/
+	while((pckt_inst->rx_buffer_ind - pckt_inst->rx_buffer_start) >= pckt_inst->hdr_len)
+	{
+		/*LEN that can not fit is not the start of a packet*/
+		if((pckt_inst->conf.resync == PCKT_ENABLED) && (rx_payload_len(pckt_inst) > pckt_inst->max_payload_len))
+		{
+			STATS_ADD(pckt_inst, rx_resync_bytes, 1);
+			rx_drop(pckt_inst, 1);
+			continue;
+		}
+
+		/*Update crc with the new bytes*/
+		if(pckt_inst->conf.crc_running == PCKT_ENABLED)
+		{
+			PROF_START(pckt_inst, PCKT_PROF_RX_CRC, prof_crc);
+			rx_crc_run(pckt_inst);
+			PROF_END(pckt_inst, PCKT_PROF_RX_CRC, prof_crc);
+		}
 
-    for(i = 0; i < sizeof(bit32_dat); i++)
-    {
-        bit32_dat._uint |= ((uint32_t)big_endian_data[i] << (sizeof(bit32_dat) - 1 - i) * 8);
-    }
+		/*Check for complete packet*/
+		if((pckt_inst->rx_buffer_ind - pckt_inst->rx_buffer_start) < rx_frame_len(pckt_inst)) break;
 
-    return bit32_dat;
+		rx_frame(pckt_inst, handler);
+	}
 }
 
 /******************************************************************************
-*  \brief Unserialize 64bit
+*  \brief Received frame length
 *
-*  \note
+*  \note total bytes of the packet at the start of rx_buffer, only valid once
+*        LEN is received. Adds [ID:0, ID:1][LEN][CRC16:0, CRC16:1] or the
+*        ext_len header and crc
 ******************************************************************************/
-static bit64_dat_t unsr_64(const uint8_t * const big_endian_data)
+static uint16_t rx_frame_len(const pckt_inst_t * const pckt_inst)
 {
-    uint8_t i;
-    bit64_dat_t bit64_dat = {0};
+	uint16_t len = rx_payload_len(pckt_inst);
 
-    for(i = 0; i < sizeof(bit64_dat); i++)
-    {
-        bit64_dat._uint |= ((uint64_t)big_endian_data[i] << (sizeof(bit64_dat) - 1 - i) * 8);
-    }
+	/*If not going to fit force it down to the max*/
+	if(len > pckt_inst->max_payload_len)
+	{
+		len = pckt_inst->max_payload_len;
+	}
 
-    return bit64_dat;
+	return len + pckt_inst->hdr_len + pckt_inst->crc_len;
 }
 
 /******************************************************************************
-*  \brief Serialize 16bit, big endian
+*  \brief Received payload length
 *
-*  \note
+*  \note LEN field of the packet at the start of rx_buffer, one byte or two
+*        with ext_len. Only valid once LEN is received
 ******************************************************************************/
-static void sr_16(uint8_t * const dest, const uint16_t src)
+static uint16_t rx_payload_len(const pckt_inst_t * const pckt_inst)
 {
-    uint8_t i;
+	const uint8_t * const len = &pckt_inst->rx_buffer[pckt_inst->rx_buffer_start + LEN_POS];
+
+	if(pckt_inst->conf.ext_len == PCKT_ENABLED)
+	{
+		return pckt_unsr_u16(len);
+	}
 
-    for(i = 0; i < sizeof(src); i++)
-    {
-        dest[i] = (uint8_t)(src >> (sizeof(src) - 1 - i) * 8);
-    }
+	return len[0];
 }
 
 /******************************************************************************
-*  \brief Serialize 32bit, big endian
+*  \brief Received frame
 *
-*  \note
+*  \note checks crc of the complete packet at the start of rx_buffer, removes
+*        it from the buffer and runs command handler
 ******************************************************************************/
-static void sr_32(uint8_t * const dest, const uint32_t src)
+static void rx_frame(pckt_inst_t * const pckt_inst, const rx_handler_t * const handler)
 {
-    uint8_t i;
+	const uint8_t * const frame = &pckt_inst->rx_buffer[pckt_inst->rx_buffer_start];
+	const uint16_t frame_len = rx_frame_len(pckt_inst);
+	pckt_view_t * const rx_view = &pckt_inst->rx_view;
+	pckt_rx_hook_t *hook;
+	pckt_rx_t pckt_rx;
+
+	/*Copy LEN*/
+	rx_view->len = frame_len - (pckt_inst->hdr_len + pckt_inst->crc_len);
+
+	/*Calculate checksum - performed on [ID:0, ID:1][LEN][PAYLOAD:0 ...,  PAYLOAD:n] if LEN=0 then just [ID:0, ID:1][LEN]*/
+	if(pckt_inst->conf.crc_running == PCKT_ENABLED)
+	{
+		/*Already up to date, see rx_crc_run()*/
+		pckt_inst->calc_crc_16_checksum = pckt_inst->rx_crc_run;
+
+		if(pckt_inst->conf.ext_len != PCKT_ENABLED)
+		{
+			pckt_inst->calc_crc_16_checksum ^= pckt_inst->conf.crc_16_xor_out;
+		}
+	}
+	else if(pckt_inst->conf.ext_len == PCKT_ENABLED)
+	{
+		PROF_START(pckt_inst, PCKT_PROF_RX_CRC, prof_crc);
+		pckt_inst->calc_crc_16_checksum = pckt_inst->conf.crc_32_update_fptr(0, frame, (frame_len - EXT_CRC_LEN));
+		PROF_END(pckt_inst, PCKT_PROF_RX_CRC, prof_crc);
+	}
+	else
+	{
+		PROF_START(pckt_inst, PCKT_PROF_RX_CRC, prof_crc);
+		pckt_inst->calc_crc_16_checksum = calc_crc(pckt_inst, frame, (frame_len - 2)); //subtract 2 bytes for [CRC16:0, CRC16:1]
+		PROF_END(pckt_inst, PCKT_PROF_RX_CRC, prof_crc);
+	}
+
+	/*Copy received CRC checksum*/
+	if(pckt_inst->conf.ext_len == PCKT_ENABLED)
+	{
+		rx_view->crc_16_checksum = pckt_unsr_u32(&frame[frame_len - EXT_CRC_LEN]);
+	}
+	else
+	{
+		rx_view->crc_16_checksum = UNSERIALIZE_UINT16(frame[CRC1_POS(rx_view->len)], frame[CRC0_POS(rx_view->len)]);
+	}
+
+	/*Check if calculated checksum matches received*/
+	if(pckt_inst->calc_crc_16_checksum != rx_view->crc_16_checksum)
+	{
+		if(pckt_inst->conf.resync == PCKT_ENABLED)
+		{
+			/*One error per resync, every byte slid past would fail as well*/
+			if(pckt_inst->rx_resyncing == 0)
+			{
+				pckt_inst->rx_resyncing = 1;
+				pckt_err_send(pckt_inst, PCKT_ERR_ID_CHKSM);
+			}
+
+			/*Try again one byte later*/
+			STATS_ADD(pckt_inst, rx_resync_bytes, 1);
+			rx_drop(pckt_inst, 1);
+		}
+		else
+		{
+			rx_clear(pckt_inst);
+			pckt_err_send(pckt_inst, PCKT_ERR_ID_CHKSM);
+		}
+
+		return;
+	}
+
+	pckt_inst->rx_resyncing = 0;
 
-    for(i = 0; i < sizeof(src); i++)
-    {
-        dest[i] = (uint8_t)(src >> (sizeof(src) - 1 - i) * 8);
-    }
+	/*Copy ID*/
+	rx_view->id      = UNSERIALIZE_UINT16(frame[ID_1_POS], frame[ID_0_POS]);
+	rx_view->payload = &frame[pckt_inst->hdr_len];
+
+	/*Remove packet from buffer - before the handler so it can send and receive, contents stay until more bytes are fed*/
+	rx_drop(pckt_inst, frame_len);
+
+	STATS_ADD(pckt_inst, rx_frames, 1);
+	stats_id(pckt_inst, rx_view->id, rx_view->len);
+
+	/*Layers first*/
+	PROF_START(pckt_inst, PCKT_PROF_RX_HANDLER, prof_handler);
+
+	for(hook = pckt_inst->rx_hook; hook != 0; hook = hook->next)
+	{
+		if(hook->fptr(hook->ctx, pckt_inst, rx_view))
+		{
+			PROF_END(pckt_inst, PCKT_PROF_RX_HANDLER, prof_handler);
+			return;
+		}
+	}
+
+	/*Run command handler*/
+	if(handler->view_handler_fptr != 0)
+	{
+		handler->view_handler_fptr(pckt_inst, rx_view);
+	}
+	else if(rx_view->len > MAX_PAYLOAD_LEN_BYTES)
+	{
+		/*Instance buffer is bigger than pckt_rx_t, use a view handler for these*/
+		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
+	}
+	else
+	{
+		/*Copy packet, on the stack as the handler gets it by value, pckt_rx_* keep reading the frame*/
+		pckt_rx.id              = rx_view->id;
+		pckt_rx.len             = (uint8_t)rx_view->len;
+		pckt_rx.crc_16_checksum = (uint16_t)rx_view->crc_16_checksum;
+		PROF_START(pckt_inst, PCKT_PROF_RX_COPY, prof_copy);
+		memcpy(pckt_rx.payload, rx_view->payload, rx_view->len);
+		PROF_END(pckt_inst, PCKT_PROF_RX_COPY, prof_copy);
+
+		handler->cmd_handler_fptr(pckt_inst, pckt_rx);
+	}
+
+	PROF_END(pckt_inst, PCKT_PROF_RX_HANDLER, prof_handler);
 }
 
 /******************************************************************************
-*  \brief Serialize 64bit, big endian
+*  \brief Received crc running update
 *
-*  \note
+*  \note adds the rx_buffer bytes not yet in rx_crc_run, stops before
+*        [CRC16:0, CRC16:1] or the crc-32c once LEN is known
 ******************************************************************************/
-static void sr_64(uint8_t * const dest, const uint64_t src)
+static void rx_crc_run(pckt_inst_t * const pckt_inst)
 {
-    uint8_t i;
+	uint16_t crc_end = pckt_inst->rx_buffer_ind;
+
+	if(((crc_end - pckt_inst->rx_buffer_start) >= pckt_inst->hdr_len) && (crc_end > (pckt_inst->rx_buffer_start + rx_frame_len(pckt_inst) - pckt_inst->crc_len)))
+	{
+		crc_end = pckt_inst->rx_buffer_start + rx_frame_len(pckt_inst) - pckt_inst->crc_len;
+	}
+
+	if(crc_end > pckt_inst->rx_crc_ind)
+	{
+		if(pckt_inst->conf.ext_len == PCKT_ENABLED)
+		{
+			pckt_inst->rx_crc_run = pckt_inst->conf.crc_32_update_fptr(pckt_inst->rx_crc_run, &pckt_inst->rx_buffer[pckt_inst->rx_crc_ind], crc_end - pckt_inst->rx_crc_ind);
+		}
+		else
+		{
+			pckt_inst->rx_crc_run = pckt_inst->conf.crc_16_update_fptr((crc_t)pckt_inst->rx_crc_run, &pckt_inst->rx_buffer[pckt_inst->rx_crc_ind], crc_end - pckt_inst->rx_crc_ind);
+		}
 
-    for(i = 0; i < sizeof(src); i++)
-    {
-        dest[i] = (uint8_t)(src >> (sizeof(src) - 1 - i) * 8);
-    }
+		pckt_inst->rx_crc_ind = crc_end;
+	}
+}
+
+/******************************************************************************
+*  \brief Clear receive buffer
+*
+*  \note
+******************************************************************************/
+static void rx_clear(pckt_inst_t * const pckt_inst)
+{
+	pckt_inst->rx_buffer_start = 0;
+	pckt_inst->rx_buffer_ind   = 0;
+	pckt_inst->rx_crc_run      = CRC_INIT(pckt_inst);
+	pckt_inst->rx_crc_ind      = 0;
+}
+
+/******************************************************************************
+*  \brief Drop bytes from the start of the receive buffer
+*
+*  \note the bytes stay in memory until rx_compact()
+******************************************************************************/
+static void rx_drop(pckt_inst_t * const pckt_inst, const uint16_t num_bytes)
+{
+	pckt_inst->rx_buffer_start += num_bytes;
+
+	if(pckt_inst->rx_buffer_start >= pckt_inst->rx_buffer_ind)
+	{
+		rx_clear(pckt_inst);
+	}
+	else
+	{
+		/*Running crc starts over at the new start*/
+		pckt_inst->rx_crc_run = CRC_INIT(pckt_inst);
+		pckt_inst->rx_crc_ind = pckt_inst->rx_buffer_start;
+	}
+}
+
+/******************************************************************************
+*  \brief Compact receive buffer
+*
+*  \note moves the bytes after rx_buffer_start to the start of the buffer
+******************************************************************************/
+static void rx_compact(pckt_inst_t * const pckt_inst)
+{
+	memmove(pckt_inst->rx_buffer, &pckt_inst->rx_buffer[pckt_inst->rx_buffer_start], pckt_inst->rx_buffer_ind - pckt_inst->rx_buffer_start);
+
+	pckt_inst->rx_buffer_ind  -= pckt_inst->rx_buffer_start;
+	pckt_inst->rx_crc_ind     -= pckt_inst->rx_buffer_start;
+	pckt_inst->rx_buffer_start = 0;
+}
+
+/******************************************************************************
+*  \brief Calculate crc
+*
+*  \note uses crc_16_fptr, or crc_16_update_fptr when len does not fit its
+*        8 bit length
+******************************************************************************/
+static crc_t calc_crc(const pckt_inst_t * const pckt_inst, const uint8_t * const data, const uint16_t len)
+{
+	if(len > UINT8_MAX)
+	{
+		return pckt_inst->conf.crc_16_update_fptr(pckt_inst->conf.crc_16_init, data, len) ^ pckt_inst->conf.crc_16_xor_out;
+	}
+
+	return pckt_inst->conf.crc_16_fptr(data, (uint8_t)len);
+}
+
+/******************************************************************************
+*  \brief CRC-16 functions match
+*
+*  \note returns 1 when crc_16_update_fptr, whole and in two parts, gives the
+*        same crc as crc_16_fptr over a fixed vector
+******************************************************************************/
+static uint8_t crc_match(const pckt_conf_t * const pckt_conf)
+{
+	static const uint8_t vec[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+	const crc_t crc = pckt_conf->crc_16_fptr(vec, sizeof(vec));
+	crc_t crc_update;
+
+	crc_update = pckt_conf->crc_16_update_fptr(pckt_conf->crc_16_init, vec, sizeof(vec));
+
+	if((crc_t)(crc_update ^ pckt_conf->crc_16_xor_out) != crc) return 0;
+
+	crc_update = pckt_conf->crc_16_update_fptr(pckt_conf->crc_16_init, vec, 4);
+	crc_update = pckt_conf->crc_16_update_fptr(crc_update, &vec[4], sizeof(vec) - 4);
+
+	return (crc_t)(crc_update ^ pckt_conf->crc_16_xor_out) == crc;
+}
+
+/******************************************************************************
+*  \brief TX data
+*
+*  \note splits data longer than the 8 bit length of tx_data_fprt
+******************************************************************************/
+static void tx_data(const pckt_inst_t * const pckt_inst, const uint8_t * data, uint16_t len)
+{
+	uint8_t tx_len;
+
+	while(len > 0)
+	{
+		tx_len = (len > UINT8_MAX) ? UINT8_MAX : (uint8_t)len;
+
+		pckt_inst->conf.tx_data_fprt(data, tx_len);
+
+		data += tx_len;
+		len  -= tx_len;
+	}
+}
+
+/******************************************************************************
+*  \brief TX build packet
+*
+*  \note writes the complete packet to pckt, returns its length
+******************************************************************************/
+static uint16_t tx_build(const pckt_inst_t * const pckt_inst, uint8_t * const pckt, const uint16_t id, const pckt_tx_seg_t * const segs, const uint8_t num_segs, const uint16_t len)
+{
+	const uint8_t hdr_len = tx_hdr(pckt_inst, pckt, id, len);
+	uint16_t ind = hdr_len;
+	uint32_t checksum;
+	uint8_t i;
+
+	/*Copy data to holding array*/
+	for(i = 0; i < num_segs; i++)
+	{
+		if(segs[i].len > 0)
+		{
+			memcpy(&pckt[ind], segs[i].data, segs[i].len);
+			ind += segs[i].len;
+		}
+	}
+
+	/*Calc and copy checksum*/
+	if(pckt_inst->conf.ext_len == PCKT_ENABLED)
+	{
+		checksum = pckt_inst->conf.crc_32_update_fptr(0, pckt, (hdr_len + len));
+		pckt_sr_u32(&pckt[hdr_len + len], checksum);
+	}
+	else
+	{
+		checksum = calc_crc(pckt_inst, pckt, (len + 3));
+		pckt[CRC1_POS(len)] = (uint8_t)(checksum >> 8);
+		pckt[CRC0_POS(len)] = (uint8_t)checksum;
+	}
+
+	return hdr_len + len + pckt_inst->crc_len;
+}
+
+/******************************************************************************
+*  \brief TX header
+*
+*  \note writes [ID:1, ID:0][LEN], returns its length
+******************************************************************************/
+static uint8_t tx_hdr(const pckt_inst_t * const pckt_inst, uint8_t * const hdr, const uint16_t id, const uint16_t len)
+{
+	hdr[ID_1_POS] = (uint8_t)(id >> 8);
+	hdr[ID_0_POS] = (uint8_t)id;
+
+	if(pckt_inst->conf.ext_len == PCKT_ENABLED)
+	{
+		pckt_sr_u16(&hdr[LEN_POS], len);
+	}
+	else
+	{
+		hdr[LEN_POS] = (uint8_t)len;
+	}
+
+	return pckt_inst->hdr_len;
+}
+
+/******************************************************************************
+*  \brief TX vectored
+*
+*  \note sends [ID:1, ID:0][LEN], payload segments straight from the caller
+*        and [CRC16:1, CRC16:0] as separate segments, crc is continued over the
+*        segments with crc_16_update_fptr (crc_32_update_fptr with ext_len).
+*        Without tx_vec_fptr each segment goes through tx_data_fprt
+******************************************************************************/
+static void tx_vec(const pckt_inst_t * const pckt_inst, const uint16_t id, const pckt_tx_seg_t * const segs, const uint8_t num_segs, const uint16_t len)
+{
+	uint8_t hdr[EXT_HDR_LEN];
+	uint8_t crc[EXT_CRC_LEN];
+	pckt_tx_seg_t seg[PCKT_TX_GATHER_MAX_SEGS + 2];
+	uint8_t num_seg = 0;
+	uint8_t i;
+	const uint8_t hdr_len = tx_hdr(pckt_inst, hdr, id, len);
+	uint32_t checksum;
+
+	/*Header*/
+	seg[num_seg].data = hdr;
+	seg[num_seg].len  = hdr_len;
+	num_seg++;
+
+	/*Payload*/
+	for(i = 0; i < num_segs; i++)
+	{
+		if(segs[i].len > 0)
+		{
+			seg[num_seg++] = segs[i];
+		}
+	}
+
+	/*Calc checksum over header and payload segments*/
+	checksum = CRC_INIT(pckt_inst);
+
+	for(i = 0; i < num_seg; i++)
+	{
+		checksum = crc_next(pckt_inst, checksum, seg[i].data, seg[i].len);
+	}
+
+	/*CRC*/
+	seg[num_seg].data = crc;
+	seg[num_seg].len  = crc_put(pckt_inst, checksum, crc);
+	num_seg++;
+
+	/*TX packet*/
+	if(pckt_inst->conf.tx_vec_fptr != 0)
+	{
+		pckt_inst->conf.tx_vec_fptr(seg, num_seg);
+		return;
+	}
+
+	for(i = 0; i < num_seg; i++)
+	{
+		tx_data(pckt_inst, seg[i].data, seg[i].len);
+	}
+}
+
+/******************************************************************************
+*  \brief TX segment
+*
+*  \note one tx_vec_fptr call, or tx_data_fprt calls of up to 255 bytes
+******************************************************************************/
+static void tx_seg(const pckt_inst_t * const pckt_inst, const uint8_t * const data, const uint16_t len)
+{
+	pckt_tx_seg_t seg;
+
+	if(pckt_inst->conf.tx_vec_fptr != 0)
+	{
+		seg.data = data;
+		seg.len  = len;
+
+		pckt_inst->conf.tx_vec_fptr(&seg, 1);
+		return;
+	}
+
+	tx_data(pckt_inst, data, len);
+}
+
+/******************************************************************************
+*  \brief TX array
+*
+*  \note sends up to max_payload_len worth of count values of width bytes.
+*        Arrays that fit TX_ARRAY_CHUNK_LEN go through pckt_tx_raw(), longer
+*        ones are serialized and sent a chunk at a time after the packets
+*        already in batch, with the crc continued over the chunks
+******************************************************************************/
+static void tx_array(pckt_inst_t * const pckt_inst, const uint16_t id, const void * const data, uint16_t count, const uint8_t width)
+{
+	uint8_t chunk[TX_ARRAY_CHUNK_LEN];
+	const uint8_t * src = (const uint8_t *)data;
+	uint16_t len;
+	uint16_t num;
+	uint32_t checksum;
+
+	/*Limit count*/
+	count = (count > (pckt_inst->max_payload_len / width)) ? (pckt_inst->max_payload_len / width) : count;
+	len   = count * width;
+
+	if(len <= sizeof(chunk))
+	{
+		pckt_sr_array(chunk, src, count, width);
+		pckt_tx_raw(pckt_inst, id, chunk, len);
+		return;
+	}
+
+	/*If packet is disabled do not run*/
+	if(pckt_inst->conf.enable == PCKT_DISABLED) return;
+
+	PROF_START(pckt_inst, PCKT_PROF_TX, prof_tx);
+
+	STATS_ADD(pckt_inst, tx_frames, 1);
+	STATS_ADD(pckt_inst, tx_bytes, len + pckt_inst->hdr_len + pckt_inst->crc_len);
+
+	/*Keep order with packets already in batch*/
+	pckt_flush_tx(pckt_inst);
+
+	/*Header*/
+	num      = tx_hdr(pckt_inst, chunk, id, len);
+	checksum = crc_next(pckt_inst, CRC_INIT(pckt_inst), chunk, num);
+	tx_seg(pckt_inst, chunk, num);
+
+	/*Payload*/
+	while(count > 0)
+	{
+		num = (count > (sizeof(chunk) / width)) ? (sizeof(chunk) / width) : count;
+
+		pckt_sr_array(chunk, src, num, width);
+		checksum = crc_next(pckt_inst, checksum, chunk, num * width);
+		tx_seg(pckt_inst, chunk, num * width);
+
+		src   += num * width;
+		count -= num;
+	}
+
+	/*CRC*/
+	tx_seg(pckt_inst, chunk, crc_put(pckt_inst, checksum, chunk));
+	PROF_END(pckt_inst, PCKT_PROF_TX, prof_tx);
+}
+
+/******************************************************************************
+*  \brief RX array
+*
+*  \note payload of the last packet must be a whole number of values of width
+*        bytes and fit max_count
+******************************************************************************/
+static pckt_rx_valid_t rx_array(pckt_inst_t * const pckt_inst, void * const dest, const uint8_t width, const uint16_t max_count, uint16_t * const count)
+{
+	if(((pckt_inst->rx_view.len % width) != 0) || ((pckt_inst->rx_view.len / width) > max_count))
+	{
+		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);
+		return PCKT_INVALID_LEN;
+	}
+
+	*count = pckt_inst->rx_view.len / width;
+
+	pckt_unsr_array(dest, pckt_inst->rx_view.payload, *count, width);
+
+	return PCKT_VALID_LEN;
+}
+
+/******************************************************************************
+*  \brief CRC next
+*
+*  \note continues crc over len bytes of data with crc_16_update_fptr, or
+*        crc_32_update_fptr with ext_len. Start from CRC_INIT()
+******************************************************************************/
+static uint32_t crc_next(const pckt_inst_t * const pckt_inst, const uint32_t crc, const uint8_t * const data, const uint16_t len)
+{
+	if(pckt_inst->conf.ext_len == PCKT_ENABLED)
+	{
+		return pckt_inst->conf.crc_32_update_fptr(crc, data, len);
+	}
+
+	return pckt_inst->conf.crc_16_update_fptr((crc_t)crc, data, len);
+}
+
+/******************************************************************************
+*  \brief CRC put
+*
+*  \note finishes crc from crc_next() and writes it big endian to dest,
+*        returns crc_len
+******************************************************************************/
+static uint8_t crc_put(const pckt_inst_t * const pckt_inst, const uint32_t crc, uint8_t * const dest)
+{
+	if(pckt_inst->conf.ext_len == PCKT_ENABLED)
+	{
+		pckt_sr_u32(dest, crc);
+	}
+	else
+	{
+		pckt_sr_u16(dest, (uint16_t)(crc ^ pckt_inst->conf.crc_16_xor_out));
+	}
+
+	return pckt_inst->crc_len;
+}
+
+/******************************************************************************
+*  \brief Default tx data function
+*
+*  \note
+******************************************************************************/
+static void dflt_tx_data(const uint8_t * const data, const uint8_t length)
+{
+	//empty
+}
+
+/******************************************************************************
+*  \brief Vector byte swap
+*
+*  \note reverses the bytes of each width byte value, 16 bytes at a time.
+*        Returns number of bytes done, 0 without SIMD
+******************************************************************************/
+static uint16_t bswap_simd(uint8_t * const dest, const uint8_t * const src, const uint16_t num_bytes, const uint8_t width)
+{
+	uint16_t i = 0;
+
+	if((width != 2) && (width != 4) && (width != 8)) return 0;
+
+#if defined(BSWAP_SSE2)
+	__m128i v;
+
+	for(i = 0; (i + 16u) <= num_bytes; i += 16)
+	{
+		v = _mm_loadu_si128((const __m128i *)&src[i]);
+
+		/*Reverse 16 bit words in each value, then bytes in each word*/
+		if(width == 4)
+		{
+			v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+			v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		}
+		else if(width == 8)
+		{
+			v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+			v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+		}
+
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+		_mm_storeu_si128((__m128i *)&dest[i], v);
+	}
+#elif defined(BSWAP_NEON)
+	uint8x16_t v;
+
+	for(i = 0; (i + 16u) <= num_bytes; i += 16)
+	{
+		v = vld1q_u8(&src[i]);
+
+		if(width == 2)      v = vrev16q_u8(v);
+		else if(width == 4) v = vrev32q_u8(v);
+		else                v = vrev64q_u8(v);
+
+		vst1q_u8(&dest[i], v);
+	}
+#else
+	(void)dest;
+	(void)src;
+	(void)num_bytes;
+	(void)width;
+#endif
+
+	return i;
+}
+
+/******************************************************************************
+*  \brief Statistics per ID
+*
+*  \note counts the packet in its ID entry. An ID without one takes the least
+*        used entry and continues its count (space saving), so an ID needs
+*        more packets than that entry had to be replaced. A busy ID that
+*        first shows up after the entries are full still gets one, while
+*        rare IDs replace each other
+******************************************************************************/
+static void stats_id(pckt_inst_t * const pckt_inst, const uint16_t id, const uint16_t len)
+{
+#if PCKT_STATS_EN
+	pckt_stats_id_t *entry = &pckt_inst->stats.ids[0];
+	uint8_t i;
+
+	for(i = 0; i < PCKT_STATS_IDS; i++)
+	{
+		if((pckt_inst->stats.ids[i].id == id) && (pckt_inst->stats.ids[i].rx_frames > 0))
+		{
+			entry = &pckt_inst->stats.ids[i];
+			break;
+		}
+
+		if(pckt_inst->stats.ids[i].rx_frames < entry->rx_frames)
+		{
+			entry = &pckt_inst->stats.ids[i];
+		}
+	}
+
+	/*New ID*/
+	if((entry->id != id) || (entry->rx_frames == 0))
+	{
+		entry->id             = id;
+		entry->rx_frames_over = entry->rx_frames;
+		entry->rx_bytes       = 0;
+	}
+
+	entry->rx_frames++;
+	entry->rx_bytes += len;
+#else
+	(void)pckt_inst;
+	(void)id;
+	(void)len;
+#endif
+}
+
+/******************************************************************************
+*  \brief Error task
+*
+*  \note sends deferred replies once err_rply_interval allows, or the summary
+*        every err_summary_period if there were errors
+******************************************************************************/
+static void err_task(pckt_inst_t * const pckt_inst)
+{
+	uint8_t summary[PCKT_ERR_TYPES * sizeof(uint16_t)];
+	uint8_t ind;
+
+	if(pckt_inst->conf.err_rply == PCKT_ERR_RPLY_DEFERRED)
+	{
+		for(ind = 0; ind < PCKT_ERR_TYPES; ind++)
+		{
+			if((pckt_inst->err_pend & (1 << ind)) && err_ready(pckt_inst, ind))
+			{
+				pckt_inst->err_pend &= (uint8_t)~(1 << ind);
+				err_tx(pckt_inst, (pckt_err_id_t)(0xFFFF - ind), pckt_inst->err_pend_id[ind]);
+			}
+		}
+	}
+	/*Quiet line, no summary and no clock read*/
+	else if((pckt_inst->err_pend != 0) && (pckt_tick_elapsed(pckt_inst, pckt_inst->err_summary_tick) >= pckt_inst->conf.err_summary_period))
+	{
+		pckt_inst->err_summary_tick = pckt_get_tick(pckt_inst);
+		pckt_inst->err_pend         = 0;
+
+		for(ind = 0; ind < PCKT_ERR_TYPES; ind++)
+		{
+			pckt_sr_u16(&summary[ind * sizeof(uint16_t)], pckt_inst->err_count[ind]);
+			pckt_inst->err_count[ind] = 0;
+		}
+
+		pckt_tx_raw(pckt_inst, PCKT_ERR_ID_SUMMARY, summary, sizeof(summary));
+	}
+}
+
+/******************************************************************************
+*  \brief Tick remain
+*
+*  \note keeps the least ticks left of timeouts of limit started at since, 0
+*        for one already passed
+******************************************************************************/
+static void tick_remain(const TICK_TYPE now, const TICK_TYPE since, const TICK_TYPE limit, TICK_TYPE * const remain, uint8_t * const found)
+{
+	const TICK_TYPE elapsed = (TICK_TYPE)(now - since);
+	const TICK_TYPE left    = (elapsed >= limit) ? 0 : (TICK_TYPE)(limit - elapsed);
+
+	if((*found == 0) || (left < *remain))
+	{
+		*remain = left;
+	}
+
+	*found = 1;
+}
+
+/******************************************************************************
+*  \brief Error ready
+*
+*  \note returns 1 and restarts the interval if a reply of this type can be
+*        sent now, 0 if err_rply_interval has not passed since the last one
+******************************************************************************/
+static uint8_t err_ready(pckt_inst_t * const pckt_inst, const uint8_t ind)
+{
+	if((pckt_inst->conf.err_rply_interval[ind] > 0) && (pckt_inst->err_sent & (1 << ind)) && (pckt_tick_elapsed(pckt_inst, pckt_inst->err_tick[ind]) < pckt_inst->conf.err_rply_interval[ind]))
+	{
+		return 0;
+	}
+
+	pckt_inst->err_sent |= (uint8_t)(1 << ind);
+	pckt_inst->err_tick[ind] = pckt_get_tick(pckt_inst);
+
+	return 1;
+}
+
+/******************************************************************************
+*  \brief Error transmit
+*
+*  \note
+******************************************************************************/
+static void err_tx(pckt_inst_t * const pckt_inst, const pckt_err_id_t error, const uint16_t id)
+{
+	switch(error)
+	{
+		//zero byte payload
+		case PCKT_ERR_ID_CHKSM:
+		case PCKT_ERR_ID_TO:
+		case PCKT_ERR_ID_ACK:
+		case PCKT_ERR_ID_NACK:
+			pckt_tx_raw(pckt_inst, (uint16_t)error, 0, 0);
+			break;
+
+		//offending ID as payload
+		case PCKT_ERR_ID_RX_LEN:
+		case PCKT_ERR_ID_UKN_ID:
+			pckt_tx_u16(pckt_inst, error, id);
+			break;
+
+		default:
+			break;
+	}
 }
@@ -11,6 +11,9 @@
 
 
 #include <stdint.h>
+#include <stddef.h>
+
+#include "pckt_prof.h"
 
 
 /**************************************************************************************************
@@ -24,13 +27,38 @@
  */
 
 #ifndef MAX_PAYLOAD_LEN_BYTES
-#define MAX_PAYLOAD_LEN_BYTES 8 //max of 255
+#define MAX_PAYLOAD_LEN_BYTES 8 //max of 255, default for instances without conf.rx_buffer and max for pckt_rx_t
 #endif
 
 #define RX_BUFFER_LEN_BYTES (MAX_PAYLOAD_LEN_BYTES + 5) /*the +5 is [ID:0, ID:1][LEN][CRC16:0, CRC16:1]*/
+#define RX_EXT_BUFFER_LEN_BYTES (MAX_PAYLOAD_LEN_BYTES + 8) /*ext_len, the +8 is [ID:0, ID:1][LEN:0, LEN:1][CRC32:0 ... CRC32:3]*/
+
+#ifndef PCKT_RX_BUFFER_EMBED_EN
+#define PCKT_RX_BUFFER_EMBED_EN 1 //every instance has an RX_EXT_BUFFER_LEN_BYTES receive buffer for use without conf.rx_buffer. Define PCKT_RX_BUFFER_EMBED_EN=0 to remove it, conf.rx_buffer is then required
+#endif
+
+#ifndef PCKT_RX_BLOCK_LEN_BYTES
+#define PCKT_RX_BLOCK_LEN_BYTES 64 //stack chunk pckt_task() reads through rx_block_fptr per call
+#endif
+
+#ifndef PCKT_TX_GATHER_MAX_SEGS
+#define PCKT_TX_GATHER_MAX_SEGS 4 //max payload segments of one pckt_tx_gather() call
+#endif
 
 #ifndef TICK_TYPE
-#define TICK_TYPE uint32_t
+#define TICK_TYPE uint32_t //define TICK_TYPE=uint64_t for ns clocks, 32 bits of ns wrap every 4.29 s
+#endif
+
+#ifndef PCKT_TICK_GLOBAL_EN
+#define PCKT_TICK_GLOBAL_EN 1 //instances without tick_ptr or tick_fptr use g_tick_ms_ptr of timer.h. Define PCKT_TICK_GLOBAL_EN=0 if every instance has its own clock
+#endif
+
+#ifndef PCKT_STATS_EN
+#define PCKT_STATS_EN 0 //per instance counters, see pckt_stats_get(). Define PCKT_STATS_EN=1 to add them, received packets then also scan PCKT_STATS_IDS entries
+#endif
+
+#ifndef PCKT_STATS_IDS
+#define PCKT_STATS_IDS 8 //received IDs with their own counters, the busiest are kept
 #endif
 
 //Packet error IDs, these are reserved IDs
@@ -46,9 +74,17 @@ typedef enum pckt_err_id_t
 
 	//Sends zero byte response packet
 	PCKT_ERR_ID_ACK      = 0xFF06, //Generic acknowledgment (User handled error)
-	PCKT_ERR_ID_NACK     = 0xFF15  //Generic negative acknowledgment (User handled error)
+	PCKT_ERR_ID_NACK     = 0xFF15, //Generic negative acknowledgment (User handled error)
+
+	//Sends [CHKSM:1, CHKSM:0][TO:1, TO:0][RX_LEN:1, RX_LEN:0][UKN_ID:1, UKN_ID:0] error counts, see PCKT_ERR_RPLY_SUMMARY
+	PCKT_ERR_ID_SUMMARY  = 0xFFFB
+
+	//IDs 0xFFF0 - 0xFFFA are used by the optional layers, see pckt_frag.h, pckt_rel.h and pckt_req.h
 } pckt_err_id_t;
 
+#define PCKT_ERR_TYPES 4                             //CHKSM, TO, RX_LEN and UKN_ID, the errors err_rply applies to
+#define PCKT_ERR_IND(error) (0xFFFF - (error))       //0 to PCKT_ERR_TYPES - 1 for those errors, index of err_rply_interval
+
 /*Packet enable disable enum*/
 typedef enum pckt_en_t
 {
@@ -56,6 +92,15 @@ typedef enum pckt_en_t
 	PCKT_ENABLED
 } pckt_en_t;
 
+/*Error reply policy, PCKT_DISABLED and PCKT_ENABLED still work as the first two*/
+typedef enum pckt_err_rply_t
+{
+	PCKT_ERR_RPLY_DISABLED  = PCKT_DISABLED, //no error replies
+	PCKT_ERR_RPLY_IMMEDIATE = PCKT_ENABLED,  //reply from where the error is found, also inside the command handler
+	PCKT_ERR_RPLY_DEFERRED,                 //reply from pckt_task(), one pending reply per error type, the newest offending ID wins
+	PCKT_ERR_RPLY_SUMMARY                   //no replies, PCKT_ERR_ID_SUMMARY with the counts every err_summary_period
+} pckt_err_rply_t;
+
 /*Set up for CRC-16 (CRC-CCITT)*/
 typedef uint16_t crc_t; //The width of the CRC calculation and result. Modify the typedef for a 16 or 32-bit CRC standard.
 #define SW_CRC_POLYNOMIAL 0x1021
@@ -71,28 +116,127 @@ typedef struct pckt_rx_t
 	uint16_t crc_16_checksum;
 } pckt_rx_t;
 
+/*Packet received view, no copy of the payload
+ *payload points into the instance receive buffer and is only valid until the handler returns,
+ *the buffer is reused for the next packet. Copy anything that must be kept.*/
+typedef struct pckt_view_t
+{
+	uint16_t id;
+	uint16_t len;
+	const uint8_t *payload;
+	uint32_t crc_16_checksum;                                 //crc-16, or crc-32c with ext_len
+} pckt_view_t;
+
+/*Transmit segment, one part of a packet for tx_vec_fptr*/
+typedef struct pckt_tx_seg_t
+{
+	const uint8_t *data;
+	uint16_t len;
+} pckt_tx_seg_t;
+
+/*Receive hook, lets a layer see packets before the command handler, see pckt_rx_hook_add()
+ *fptr returns 1 if it used the packet, or 0 to pass it on. It may rewrite the view, e.g. to
+ *strip its own header, the next hook and the command handler then get the rewritten view.*/
+struct pckt_inst_t;
+typedef struct pckt_rx_hook_t
+{
+	uint8_t (*fptr)(void * const, struct pckt_inst_t * const, pckt_view_t * const); //ctx, instance and view
+	void *ctx;                                                //layer state passed to fptr
+	struct pckt_rx_hook_t *next;
+} pckt_rx_hook_t;
+
+/*Received ID counters*/
+typedef struct pckt_stats_id_t
+{
+	uint16_t id;
+	uint32_t rx_frames;                                       //0 for an unused entry, up to rx_frames_over too high
+	uint32_t rx_frames_over;                                  //rx_frames of the entry this ID replaced, which it started from
+	uint32_t rx_bytes;                                        //payload bytes since the ID got the entry
+} pckt_stats_id_t;
+
+/*Packet statistics, see pckt_stats_get()*/
+typedef struct pckt_stats_t
+{
+	uint32_t rx_bytes;                                        //bytes received, including ones dropped
+	uint32_t rx_frames;                                       //valid packets received
+	uint32_t rx_crc_err;                                      //PCKT_ERR_ID_CHKSM, one per resync with resync enabled
+	uint32_t rx_timeout;                                      //PCKT_ERR_ID_TO
+	uint32_t rx_len_err;                                      //PCKT_ERR_ID_RX_LEN
+	uint32_t rx_ukn_id;                                       //PCKT_ERR_ID_UKN_ID
+	uint32_t rx_resync_bytes;                                 //bytes slid past looking for a valid packet
+	uint32_t tx_bytes;                                        //bytes of packets sent, including header and crc
+	uint32_t tx_frames;                                       //packets sent
+	uint32_t err_rply_dropped;                                //error replies not sent because of err_rply_interval or a newer deferred one
+	pckt_stats_id_t ids[PCKT_STATS_IDS];                      //busiest received IDs, a new ID replaces the least used entry and continues its count
+} pckt_stats_t;
+
 /*Packet configuration struct*/
 typedef	struct pckt_conf_t
 {
 	int16_t (*rx_byte_fptr)(void);                            //function pointer for received byte return -1 for no data or >=0 for valid data
+	uint16_t (*rx_block_fptr)(uint8_t * const, const uint16_t);//optional block read, fills up to len bytes and returns count (0 for no data), used instead of rx_byte_fptr when set
 	void (*tx_data_fprt)(const uint8_t * const, uint8_t);     //function pointer for transmit, ptr to 8 bit data array and length
-	uint16_t (*crc_16_fptr)(const uint8_t * const, uint8_t);  //function pointer for crc-16, default will be sw_crc
+	void (*tx_vec_fptr)(const pckt_tx_seg_t * const, uint8_t);//optional vectored transmit, array of segments making one packet and number of segments, used instead of tx_data_fprt when set
+	uint16_t (*crc_16_fptr)(const uint8_t * const, uint8_t);  //function pointer for crc-16, default will be sw_crc. crc_16_update_fptr must give the same crc where it is used
+	crc_t (*crc_16_update_fptr)(crc_t, const uint8_t *, uint16_t); //function pointer for incremental crc-16 continuing from a previous value, default will be sw_crc_update. Used for frames over 255 bytes, crc_running and tx_vec
+	crc_t crc_16_init;                                        //starting value for crc_16_update_fptr
+	crc_t crc_16_xor_out;                                     //final value is xored with this after the last crc_16_update_fptr
+	uint32_t (*crc_32_update_fptr)(uint32_t, const uint8_t *, uint16_t); //function pointer for incremental crc-32c used by ext_len frames, start with 0, default will be sw_crc32c_update
+	pckt_en_t ext_len;                                        //enable extended frames, 16 bit LEN and crc-32c, both ends must match
+	pckt_en_t crc_running;                                    //enable updating rx crc as bytes arrive instead of when the packet is complete
+	pckt_en_t resync;                                         //enable sliding one byte and trying again on crc error, impossible LEN or rx timeout instead of dropping the buffer
+	const volatile TICK_TYPE *tick_ptr;                       //clock of this instance, any resolution e.g. us or ns, 0 for g_tick_ms_ptr. Every timeout of the instance and its layers is in its ticks
+	TICK_TYPE (*tick_fptr)(void);                             //optional clock function, used instead of tick_ptr when set
 	TICK_TYPE clear_buffer_timeout;                           //timeout for buffer to be cleared when incomplete packet received
 	pckt_en_t enable;                                         //enable or disable packet instance
-	pckt_en_t err_rply;                                       //enable error response over tx line
+	pckt_err_rply_t err_rply;                                 //error response over tx line, see pckt_err_rply_t
+	TICK_TYPE err_rply_interval[PCKT_ERR_TYPES];              //min time between two replies of one error type, 0 for no limit, indexed with PCKT_ERR_IND()
+	TICK_TYPE err_summary_period;                             //PCKT_ERR_RPLY_SUMMARY, time between summaries
+	uint8_t *tx_batch_buffer;                                 //optional tx batch memory, packets are collected here and sent together, 0 to send each packet on its own
+	uint16_t tx_batch_size;                                   //size of tx_batch_buffer
+	uint16_t tx_batch_threshold;                              //send batch once it holds at least this many bytes
+	TICK_TYPE tx_batch_timeout;                               //send batch from pckt_task once its first packet is this old
+	uint8_t *rx_buffer;                                       //optional receive buffer, 0 to use the instance's RX_EXT_BUFFER_LEN_BYTES array, required with PCKT_RX_BUFFER_EMBED_EN=0
+	uint16_t rx_buffer_size;                                  //size of rx_buffer, instance max payload is rx_buffer_size - 5 (max of 255), or rx_buffer_size - 8 with ext_len
 } pckt_conf_t;
 
 /*Packet instance struct*/
 typedef struct pckt_inst_t
 {
 	pckt_conf_t conf;
+	struct pckt_dispatch_t *dispatch;                         //optional ID dispatch registry, see pckt_dispatch.h
+	pckt_rx_hook_t *rx_hook;                                  //optional layers run before the command handler, see pckt_rx_hook_add()
 
 	int16_t rx_byte;
-	uint8_t rx_buffer[RX_BUFFER_LEN_BYTES];
+#if PCKT_RX_BUFFER_EMBED_EN
+	uint8_t rx_buffer_arr[RX_EXT_BUFFER_LEN_BYTES];           //default receive buffer
+#endif
+	uint8_t *rx_buffer;                                       //conf.rx_buffer or rx_buffer_arr
+	uint16_t max_payload_len;                                 //largest payload received or sent by this instance
+	uint8_t hdr_len;                                          //[ID:1, ID:0][LEN] bytes, 3 or 4 with ext_len
+	uint8_t crc_len;                                          //[CRC] bytes, 2 or 4 with ext_len
+	uint16_t rx_buffer_start;                                 //first byte of the packet being received, only moves with resync
 	uint16_t rx_buffer_ind;
-	uint16_t calc_crc_16_checksum;
-	pckt_rx_t pckt_rx;
-	TICK_TYPE last_tick;
+	uint32_t calc_crc_16_checksum;                            //crc-16, or crc-32c with ext_len
+	uint32_t rx_crc_run;                                      //running crc over rx_buffer
+	uint16_t rx_crc_ind;                                      //end of rx_buffer bytes in rx_crc_run
+	uint8_t rx_resyncing;                                     //crc error sent, sliding to the next valid packet
+	pckt_view_t rx_view;                                      //last received packet, used by pckt_rx_* functions
+	TICK_TYPE last_tick;                                      //time of the last byte of a partial packet, the rx timeout is armed while rx_buffer holds one
+	uint16_t tx_batch_len;                                    //bytes in tx_batch_buffer
+	TICK_TYPE tx_batch_tick;                                  //time first packet was put in tx_batch_buffer
+	TICK_TYPE err_tick[PCKT_ERR_TYPES];                       //time of last reply per error type
+	uint8_t err_sent;                                         //bit per error type, err_tick is valid
+	uint8_t err_pend;                                         //bit per error type, PCKT_ERR_RPLY_DEFERRED reply or PCKT_ERR_RPLY_SUMMARY count waiting for pckt_task()
+	uint16_t err_pend_id[PCKT_ERR_TYPES];                     //offending ID of the pending reply
+	uint16_t err_count[PCKT_ERR_TYPES];                       //PCKT_ERR_RPLY_SUMMARY counts since the last summary
+	TICK_TYPE err_summary_tick;                               //time last summary was sent
+#if PCKT_STATS_EN
+	pckt_stats_t stats;
+#endif
+#if PCKT_PROF_EN
+	pckt_prof_t prof;                                         //stage timing, see pckt_prof.h
+#endif
 } pckt_inst_t;
 
 /*Packet return value of rx functions*/
@@ -107,11 +251,19 @@ typedef enum pckt_rx_valid_t
 *                                            PROTOTYPES
 *************************************************^************************************************/
 void     pckt_get_config_defaults(pckt_conf_t * const pckt_conf);
-void     pckt_init               (pckt_inst_t * const pckt_inst, const pckt_conf_t pckt_conf);
+int8_t   pckt_init               (pckt_inst_t * const pckt_inst, const pckt_conf_t pckt_conf);
 void     pckt_task               (pckt_inst_t * const pckt_inst, void(*cmd_handler_fptr)(pckt_inst_t * const, const pckt_rx_t));
+void     pckt_feed               (pckt_inst_t * const pckt_inst, const uint8_t * data, size_t len, void(*cmd_handler_fptr)(pckt_inst_t * const, const pckt_rx_t));
+void     pckt_task_view          (pckt_inst_t * const pckt_inst, void(*view_handler_fptr)(pckt_inst_t * const, const pckt_view_t * const));
+void     pckt_feed_view          (pckt_inst_t * const pckt_inst, const uint8_t * data, size_t len, void(*view_handler_fptr)(pckt_inst_t * const, const pckt_view_t * const));
 void     pckt_flush_rx           (pckt_inst_t * const pckt_inst);
 crc_t    pckt_sw_crc             (const uint8_t * const message, const uint8_t num_bytes);
-void     pckt_tx_raw             (pckt_inst_t * const pckt_inst, const uint16_t id, const uint8_t * const data, const uint8_t len);
+crc_t    pckt_sw_crc_update      (crc_t crc, const uint8_t * message, uint16_t num_bytes);
+uint32_t pckt_sw_crc32c_update   (uint32_t crc, const uint8_t * message, uint16_t num_bytes);
+void     pckt_flush_tx           (pckt_inst_t * const pckt_inst);
+void     pckt_tx_raw             (pckt_inst_t * const pckt_inst, const uint16_t id, const uint8_t * const data, const uint16_t len);
+void     pckt_tx_gather          (pckt_inst_t * const pckt_inst, const uint16_t id, const pckt_tx_seg_t * const segs, uint8_t num_segs);
+void     pckt_rx_hook_add        (pckt_inst_t * const pckt_inst, pckt_rx_hook_t * const hook);
 
 void     pckt_tx_u8              (pckt_inst_t * const pckt_inst, const uint16_t id, const uint8_t data);
 void     pckt_tx_s8              (pckt_inst_t * const pckt_inst, const uint16_t id, const int8_t data);
@@ -124,7 +276,21 @@ void     pckt_tx_u64             (pckt_inst_t * const pckt_inst, const uint16_t
 void     pckt_tx_s64             (pckt_inst_t * const pckt_inst, const uint16_t id, const int64_t data);
 void     pckt_tx_dbl64           (pckt_inst_t * const pckt_inst, const uint16_t id, const double data);
 
+void     pckt_tx_u16_array       (pckt_inst_t * const pckt_inst, const uint16_t id, const uint16_t * const data, const uint16_t count);
+void     pckt_tx_s16_array       (pckt_inst_t * const pckt_inst, const uint16_t id, const int16_t * const data, const uint16_t count);
+void     pckt_tx_u32_array       (pckt_inst_t * const pckt_inst, const uint16_t id, const uint32_t * const data, const uint16_t count);
+void     pckt_tx_s32_array       (pckt_inst_t * const pckt_inst, const uint16_t id, const int32_t * const data, const uint16_t count);
+void     pckt_tx_flt32_array     (pckt_inst_t * const pckt_inst, const uint16_t id, const float * const data, const uint16_t count);
+void     pckt_tx_u64_array       (pckt_inst_t * const pckt_inst, const uint16_t id, const uint64_t * const data, const uint16_t count);
+void     pckt_tx_s64_array       (pckt_inst_t * const pckt_inst, const uint16_t id, const int64_t * const data, const uint16_t count);
+void     pckt_tx_dbl64_array     (pckt_inst_t * const pckt_inst, const uint16_t id, const double * const data, const uint16_t count);
+
 void     pckt_enable             (pckt_inst_t * const pckt_inst, const pckt_en_t enable);
+void     pckt_stats_get          (const pckt_inst_t * const pckt_inst, pckt_stats_t * const stats);
+void     pckt_stats_reset        (pckt_inst_t * const pckt_inst);
+TICK_TYPE pckt_get_tick          (const pckt_inst_t * const pckt_inst);
+TICK_TYPE pckt_tick_elapsed      (const pckt_inst_t * const pckt_inst, const TICK_TYPE since);
+uint8_t  pckt_next_deadline      (const pckt_inst_t * const pckt_inst, TICK_TYPE * const deadline);
 
 pckt_rx_valid_t pckt_rx_u8       (pckt_inst_t * const pckt_inst, uint8_t * const);
 pckt_rx_valid_t pckt_rx_s8       (pckt_inst_t * const pckt_inst, int8_t * const);
@@ -137,6 +303,18 @@ pckt_rx_valid_t pckt_rx_u64      (pckt_inst_t * const pckt_inst, uint64_t * cons
 pckt_rx_valid_t pckt_rx_s64      (pckt_inst_t * const pckt_inst, int64_t * const);
 pckt_rx_valid_t pckt_rx_dbl64    (pckt_inst_t * const pckt_inst, double * const);
 
+pckt_rx_valid_t pckt_rx_u16_array(pckt_inst_t * const pckt_inst, uint16_t * const, const uint16_t max_count, uint16_t * const count);
+pckt_rx_valid_t pckt_rx_s16_array(pckt_inst_t * const pckt_inst, int16_t * const, const uint16_t max_count, uint16_t * const count);
+pckt_rx_valid_t pckt_rx_u32_array(pckt_inst_t * const pckt_inst, uint32_t * const, const uint16_t max_count, uint16_t * const count);
+pckt_rx_valid_t pckt_rx_s32_array(pckt_inst_t * const pckt_inst, int32_t * const, const uint16_t max_count, uint16_t * const count);
+pckt_rx_valid_t pckt_rx_flt32_array(pckt_inst_t * const pckt_inst, float * const, const uint16_t max_count, uint16_t * const count);
+pckt_rx_valid_t pckt_rx_u64_array(pckt_inst_t * const pckt_inst, uint64_t * const, const uint16_t max_count, uint16_t * const count);
+pckt_rx_valid_t pckt_rx_s64_array(pckt_inst_t * const pckt_inst, int64_t * const, const uint16_t max_count, uint16_t * const count);
+pckt_rx_valid_t pckt_rx_dbl64_array(pckt_inst_t * const pckt_inst, double * const, const uint16_t max_count, uint16_t * const count);
+
+void            pckt_sr_array    (uint8_t * const dest, const void * const src, const uint16_t count, const uint8_t width);
+void            pckt_unsr_array  (void * const dest, const uint8_t * const src, const uint16_t count, const uint8_t width);
+
 void            pckt_err_send    (pckt_inst_t * const pckt_inst, const pckt_err_id_t error);
 
 
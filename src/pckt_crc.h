@@ -0,0 +1,84 @@
+/*
+ * pckt_crc.h
+ *
+ * Created: 10/16/2026
+ */
+
+/*
+ * Drop in CRC-16 (CRC-CCITT) engines, all give the same result as pckt_sw_crc().
+ *
+ * HOW TO USE
+ * pckt_get_config_defaults(&pckt_conf);
+ * pckt_conf.crc_16_fptr        = pckt_slice8_crc;
+ * pckt_conf.crc_16_update_fptr = pckt_slice8_crc_update;
+ * pckt_init(&pckt_inst, pckt_conf);
+ *
+ * pckt_tbl_crc    - one 256 entry table (512 bytes), a byte at a time
+ * pckt_slice4_crc - four tables (2 KB), four bytes at a time
+ * pckt_slice8_crc - eight tables (4 KB), eight bytes at a time
+ * pckt_clmul_crc  - folds 16 bytes at a time with carry-less multiply (PCLMULQDQ)
+ *                   when the CPU has it, otherwise falls back to pckt_slice8_crc
+ *
+ * The *_update versions continue a CRC over more data, start with 0. Set both pointers to the same
+ * engine. pckt_init() fails when the instance uses crc_16_update_fptr (crc_running, tx_vec_fptr or
+ * frames over 255 bytes) and it does not give the same CRC as crc_16_fptr.
+ *
+ * CRC-32C engines for ext_len frames, same result as pckt_sw_crc32c_update()
+ * pckt_conf.crc_32_update_fptr = pckt_hw_crc32c_update;
+ *
+ * pckt_tbl_crc32c_update - one 256 entry table (1 KB), a byte at a time
+ * pckt_hw_crc32c_update  - SSE4.2 crc32 instruction, 8 bytes at a time, when the CPU has it,
+ *                          otherwise falls back to pckt_tbl_crc32c_update
+ */
+
+
+#ifndef PCKT_CRC_H_
+#define PCKT_CRC_H_
+
+
+#include "packet.h"
+
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+/*Carry-less multiply engine, only x86 has an implementation. Define PCKT_CRC_CLMUL_EN=0 to remove it*/
+#ifndef PCKT_CRC_CLMUL_EN
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define PCKT_CRC_CLMUL_EN 1
+#else
+#define PCKT_CRC_CLMUL_EN 0
+#endif
+#endif
+
+
+/*SSE4.2 crc32 engine, only x86 has an implementation. Define PCKT_CRC_HW32_EN=0 to remove it*/
+#ifndef PCKT_CRC_HW32_EN
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define PCKT_CRC_HW32_EN 1
+#else
+#define PCKT_CRC_HW32_EN 0
+#endif
+#endif
+
+/**************************************************************************************************
+*                                            PROTOTYPES
+*************************************************^************************************************/
+crc_t    pckt_tbl_crc            (const uint8_t * const message, const uint8_t num_bytes);
+crc_t    pckt_slice4_crc         (const uint8_t * const message, const uint8_t num_bytes);
+crc_t    pckt_slice8_crc         (const uint8_t * const message, const uint8_t num_bytes);
+crc_t    pckt_clmul_crc          (const uint8_t * const message, const uint8_t num_bytes);
+
+crc_t    pckt_tbl_crc_update     (crc_t crc, const uint8_t * message, uint16_t num_bytes);
+crc_t    pckt_slice4_crc_update  (crc_t crc, const uint8_t * message, uint16_t num_bytes);
+crc_t    pckt_slice8_crc_update  (crc_t crc, const uint8_t * message, uint16_t num_bytes);
+crc_t    pckt_clmul_crc_update   (crc_t crc, const uint8_t * message, uint16_t num_bytes);
+
+uint8_t  pckt_clmul_crc_avail    (void);
+
+uint32_t pckt_tbl_crc32c_update  (uint32_t crc, const uint8_t * message, uint16_t num_bytes);
+uint32_t pckt_hw_crc32c_update   (uint32_t crc, const uint8_t * message, uint16_t num_bytes);
+uint8_t  pckt_hw_crc32c_avail    (void);
+
+
+#endif /* PCKT_CRC_H_ */
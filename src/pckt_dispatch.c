@@ -0,0 +1,143 @@
+/*
+ * pckt_dispatch.c
+ *
+ * Created: 10/16/2026
+ */
+
+
+#include <string.h>
+
+#include "pckt_dispatch.h"
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#define ID_1(id) ((uint8_t)((id) >> 8))
+#define ID_0(id) ((uint8_t)(id))
+
+
+/**************************************************************************************************
+*                                            FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Dispatch init
+*
+*  \note page 0 is kept empty. Returns 0 for success or -1 if num_pages is 0,
+*        in which case the registry must not be used
+******************************************************************************/
+int8_t pckt_dispatch_init(pckt_dispatch_t * const dispatch, pckt_dispatch_page_t * const pages, const uint16_t num_pages, const pckt_dispatch_fptr_t dflt_fptr)
+{
+	if(num_pages == 0) return -1;
+
+	memset(dispatch->dir, 0, sizeof(dispatch->dir));
+	memset(pages, 0, sizeof(pckt_dispatch_page_t) * num_pages);
+
+	dispatch->pages      = pages;
+	dispatch->num_pages  = num_pages;
+	dispatch->used_pages = 1;
+	dispatch->dflt_fptr  = dflt_fptr;
+
+	return 0;
+}
+
+/******************************************************************************
+*  \brief Dispatch register
+*
+*  \note sets handler for every ID from id_first to id_last, replaces any
+*        handler already there. Returns 0 for success or -1 if there are not
+*        enough pages, in which case nothing is registered.
+******************************************************************************/
+int8_t pckt_dispatch_register(pckt_dispatch_t * const dispatch, const uint16_t id_first, const uint16_t id_last, const pckt_dispatch_fptr_t fptr)
+{
+	uint32_t id;
+	uint16_t hi;
+	uint16_t new_pages = 0;
+
+	if(id_first > id_last) return -1;
+
+	/*Check all pages needed are available before changing anything*/
+	for(hi = ID_1(id_first); hi <= ID_1(id_last); hi++)
+	{
+		if(dispatch->dir[hi] == 0) new_pages++;
+	}
+
+	if((dispatch->used_pages + new_pages) > dispatch->num_pages) return -1;
+
+	/*Set handlers*/
+	for(id = id_first; id <= id_last; id++)
+	{
+		if(dispatch->dir[ID_1(id)] == 0)
+		{
+			dispatch->dir[ID_1(id)] = dispatch->used_pages++;
+		}
+
+		dispatch->pages[dispatch->dir[ID_1(id)]].handler[ID_0(id)] = fptr;
+	}
+
+	return 0;
+}
+
+/******************************************************************************
+*  \brief Dispatch unregister
+*
+*  \note IDs go back to the default handler, pages stay allocated
+******************************************************************************/
+void pckt_dispatch_unregister(pckt_dispatch_t * const dispatch, const uint16_t id_first, const uint16_t id_last)
+{
+	uint32_t id;
+
+	for(id = id_first; id <= id_last; id++)
+	{
+		if(dispatch->dir[ID_1(id)] != 0)
+		{
+			dispatch->pages[dispatch->dir[ID_1(id)]].handler[ID_0(id)] = 0;
+		}
+	}
+}
+
+/******************************************************************************
+*  \brief Dispatch attach
+*
+*  \note registry used by pckt_dispatch_handler for this instance, one
+*        registry can be attached to several instances
+******************************************************************************/
+void pckt_dispatch_attach(pckt_inst_t * const pckt_inst, pckt_dispatch_t * const dispatch)
+{
+	pckt_inst->dispatch = dispatch;
+}
+
+/******************************************************************************
+*  \brief Dispatch handler
+*
+*  \note view handler for pckt_task_view() and pckt_feed_view(), runs the
+*        handler registered for the ID in the attached registry
+******************************************************************************/
+void pckt_dispatch_handler(pckt_inst_t * const pckt_inst, const pckt_view_t * const pckt_view)
+{
+	const pckt_dispatch_t * const dispatch = pckt_inst->dispatch;
+	pckt_dispatch_fptr_t fptr;
+
+	if(dispatch == 0) return;
+
+	fptr = dispatch->pages[dispatch->dir[ID_1(pckt_view->id)]].handler[ID_0(pckt_view->id)];
+
+	if(fptr == 0)
+	{
+		fptr = dispatch->dflt_fptr;
+		if(fptr == 0) return;
+	}
+
+	fptr(pckt_inst, pckt_view);
+}
+
+/******************************************************************************
+*  \brief Dispatch unknown ID
+*
+*  \note default handler that replies PCKT_ERR_ID_UKN_ID
+******************************************************************************/
+void pckt_dispatch_unknown_id(pckt_inst_t * const pckt_inst, const pckt_view_t * const pckt_view)
+{
+	(void)pckt_view;
+
+	pckt_err_send(pckt_inst, PCKT_ERR_ID_UKN_ID);
+}
@@ -0,0 +1,80 @@
+/*
+ * pckt_dispatch.h
+ *
+ * Created: 10/16/2026
+ */
+
+/*
+ * ID dispatch registry, replaces a switch on the ID in the command handler.
+ *
+ * HOW TO USE
+ * 1.DECLARE REGISTRY AND PAGE MEMORY
+ * static pckt_dispatch_page_t cmd_pages[4];
+ * static pckt_dispatch_t cmd_dispatch;
+ *
+ * 2.INITIALIZE, REGISTER AND ATTACH TO AN INSTANCE
+ * pckt_dispatch_init(&cmd_dispatch, cmd_pages, 4, pckt_dispatch_unknown_id);
+ * pckt_dispatch_register(&cmd_dispatch, 0x0100, 0x0100, set_speed_handler);
+ * pckt_dispatch_register(&cmd_dispatch, 0x0200, 0x02FF, param_handler);
+ * pckt_dispatch_attach(&pckt_inst, &cmd_dispatch);
+ *
+ * 3.RUN TASK WITH THE DISPATCH HANDLER
+ * pckt_task_view(&pckt_inst, pckt_dispatch_handler);
+ *
+ * TABLE
+ * Two levels indexed by ID:1 then ID:0, a lookup is two loads for any ID.
+ * Page 0 of the page memory stays empty and is shared by every ID:1 with nothing
+ * registered. Each ID:1 with a handler registered takes one page.
+ *
+ * MEMORY
+ * registry: 512 bytes + 1 pointer
+ * page:     256 pointers, 1 KB on 32 bit or 2 KB on 64 bit
+ * total:    registry + (1 + number of distinct ID:1 registered) pages
+ * e.g. 300 commands in IDs 0x0000-0x03FF on 32 bit: 512 B + 5 KB
+ *      every one of the 65536 IDs on 32 bit: 512 B + 257 KB
+ */
+
+
+#ifndef PCKT_DISPATCH_H_
+#define PCKT_DISPATCH_H_
+
+
+#include "packet.h"
+
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+/*Handler run for a dispatched ID*/
+typedef void (*pckt_dispatch_fptr_t)(pckt_inst_t * const, const pckt_view_t * const);
+
+/*Handlers for the 256 IDs sharing ID:1*/
+typedef struct pckt_dispatch_page_t
+{
+	pckt_dispatch_fptr_t handler[256];
+} pckt_dispatch_page_t;
+
+/*Dispatch registry struct*/
+typedef struct pckt_dispatch_t
+{
+	uint16_t dir[256];                   //page index for each ID:1, 0 is the empty page
+	pckt_dispatch_page_t *pages;         //user page memory
+	uint16_t num_pages;
+	uint16_t used_pages;
+	pckt_dispatch_fptr_t dflt_fptr;      //run for IDs with no handler, can be 0
+} pckt_dispatch_t;
+
+
+/**************************************************************************************************
+*                                            PROTOTYPES
+*************************************************^************************************************/
+int8_t   pckt_dispatch_init      (pckt_dispatch_t * const dispatch, pckt_dispatch_page_t * const pages, const uint16_t num_pages, const pckt_dispatch_fptr_t dflt_fptr);
+int8_t   pckt_dispatch_register  (pckt_dispatch_t * const dispatch, const uint16_t id_first, const uint16_t id_last, const pckt_dispatch_fptr_t fptr);
+void     pckt_dispatch_unregister(pckt_dispatch_t * const dispatch, const uint16_t id_first, const uint16_t id_last);
+void     pckt_dispatch_attach    (pckt_inst_t * const pckt_inst, pckt_dispatch_t * const dispatch);
+
+void     pckt_dispatch_handler   (pckt_inst_t * const pckt_inst, const pckt_view_t * const pckt_view);
+void     pckt_dispatch_unknown_id(pckt_inst_t * const pckt_inst, const pckt_view_t * const pckt_view);
+
+
+#endif /* PCKT_DISPATCH_H_ */
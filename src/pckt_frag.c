@@ -0,0 +1,329 @@
+/*
+ * pckt_frag.c
+ *
+ * Created: 10/16/2026
+ */
+
+
+#include <string.h>
+
+#include "pckt_frag.h"
+#include "pckt_sr.h"
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#define STREAM_POS 0
+#define ID_POS     1
+#define TOTAL_POS  3
+#define OFFSET_POS 7
+
+
+/**************************************************************************************************
+*                                         LOCAL PROTOTYPES
+*************************************************^************************************************/
+static uint8_t             frag_rx_hook(void * const ctx, pckt_inst_t * const pckt_inst, pckt_view_t * const pckt_view);
+static pckt_frag_stream_t *frag_find   (pckt_frag_t * const frag, const uint8_t stream);
+static pckt_frag_stream_t *frag_start  (pckt_frag_t * const frag, const uint8_t stream, const uint16_t id, const uint32_t total_len);
+static void                frag_end    (pckt_frag_t * const frag, pckt_frag_stream_t * const slot, const pckt_frag_status_t status);
+
+
+/**************************************************************************************************
+*                                            FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Fragmentation init
+*
+*  \note pool is num_streams buffers of pool_buf_size bytes, or 0 to get
+*        message buffers from alloc_fptr. Timeout defaults to 1000
+******************************************************************************/
+void pckt_frag_init(pckt_frag_t * const frag, pckt_frag_stream_t * const streams, const uint8_t num_streams, uint8_t * const pool, const uint32_t pool_buf_size, void (*done_fptr)(pckt_inst_t * const, const uint16_t, uint8_t * const, const uint32_t, const pckt_frag_status_t))
+{
+	uint8_t i;
+
+	for(i = 0; i < num_streams; i++)
+	{
+		memset(&streams[i], 0, sizeof(streams[i]));
+		streams[i].pool_buf = (pool != 0) ? &pool[i * pool_buf_size] : 0;
+	}
+
+	frag->streams       = streams;
+	frag->num_streams   = num_streams;
+	frag->pool_buf_size = (pool != 0) ? pool_buf_size : 0;
+	frag->alloc_fptr    = 0;
+	frag->done_fptr     = done_fptr;
+	frag->timeout       = 1000;
+	frag->tx_stream     = 0;
+	frag->pckt_inst     = 0;
+}
+
+/******************************************************************************
+*  \brief Fragmentation attach
+*
+*  \note adds the layer to the instance, returns 0 for success or -1 if the
+*        instance max payload can not hold a fragment header and data
+******************************************************************************/
+int8_t pckt_frag_attach(pckt_inst_t * const pckt_inst, pckt_frag_t * const frag)
+{
+	if(pckt_inst->max_payload_len <= PCKT_FRAG_HDR_LEN) return -1;
+
+	frag->pckt_inst = pckt_inst;
+	frag->hook.fptr = frag_rx_hook;
+	frag->hook.ctx  = frag;
+
+	pckt_rx_hook_add(pckt_inst, &frag->hook);
+
+	return 0;
+}
+
+/******************************************************************************
+*  \brief Fragmentation task
+*
+*  \note drops messages with no fragment for timeout, call with pckt_task()
+******************************************************************************/
+void pckt_frag_task(pckt_frag_t * const frag)
+{
+	uint8_t i;
+
+	for(i = 0; i < frag->num_streams; i++)
+	{
+		if(frag->streams[i].active && (pckt_tick_elapsed(frag->pckt_inst, frag->streams[i].last_tick) >= frag->timeout))
+		{
+			frag_end(frag, &frag->streams[i], PCKT_FRAG_TIMEOUT);
+		}
+	}
+}
+
+/******************************************************************************
+*  \brief Fragmentation TX start
+*
+*  \note sets up frag_tx to send data with pckt_frag_tx_next(), data must stay
+*        valid until the last fragment is sent
+******************************************************************************/
+void pckt_frag_tx_start(pckt_frag_t * const frag, pckt_frag_tx_t * const frag_tx, const uint16_t id, const uint8_t * const data, const uint32_t len)
+{
+	frag_tx->data   = data;
+	frag_tx->len    = len;
+	frag_tx->offset = 0;
+	frag_tx->id     = id;
+	frag_tx->stream = frag->tx_stream++;
+	frag_tx->busy   = 1;
+}
+
+/******************************************************************************
+*  \brief Fragmentation TX next
+*
+*  \note sends one fragment, as much data as the instance max payload holds.
+*        Returns bytes left, call until it returns 0. Messages started on
+*        different frag_tx can be sent interleaved
+******************************************************************************/
+uint32_t pckt_frag_tx_next(pckt_inst_t * const pckt_inst, pckt_frag_tx_t * const frag_tx)
+{
+	uint8_t hdr[PCKT_FRAG_HDR_LEN];
+	pckt_tx_seg_t seg[2];
+	uint32_t data_len;
+
+	if((frag_tx->busy == 0) || (pckt_inst->max_payload_len <= PCKT_FRAG_HDR_LEN)) return 0;
+
+	/*Fill the packet*/
+	data_len = frag_tx->len - frag_tx->offset;
+
+	if(data_len > (uint32_t)(pckt_inst->max_payload_len - PCKT_FRAG_HDR_LEN))
+	{
+		data_len = pckt_inst->max_payload_len - PCKT_FRAG_HDR_LEN;
+	}
+
+	hdr[STREAM_POS] = frag_tx->stream;
+	pckt_sr_u16(&hdr[ID_POS], frag_tx->id);
+	pckt_sr_u32(&hdr[TOTAL_POS], frag_tx->len);
+	pckt_sr_u32(&hdr[OFFSET_POS], frag_tx->offset);
+
+	seg[0].data = hdr;
+	seg[0].len  = sizeof(hdr);
+	seg[1].data = &frag_tx->data[frag_tx->offset];
+	seg[1].len  = (uint16_t)data_len;
+
+	pckt_tx_gather(pckt_inst, PCKT_FRAG_ID, seg, 2);
+
+	frag_tx->offset += data_len;
+
+	if(frag_tx->offset >= frag_tx->len)
+	{
+		frag_tx->busy = 0;
+	}
+
+	return frag_tx->len - frag_tx->offset;
+}
+
+/******************************************************************************
+*  \brief Fragmentation TX
+*
+*  \note sends every fragment of a message
+******************************************************************************/
+void pckt_frag_tx(pckt_inst_t * const pckt_inst, pckt_frag_t * const frag, const uint16_t id, const uint8_t * const data, const uint32_t len)
+{
+	pckt_frag_tx_t frag_tx;
+
+	pckt_frag_tx_start(frag, &frag_tx, id, data, len);
+
+	while(pckt_frag_tx_next(pckt_inst, &frag_tx) > 0);
+}
+
+
+/**************************************************************************************************
+*                                         LOCAL FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Fragmentation receive hook
+*
+*  \note takes every PCKT_FRAG_ID packet, copies its data to the message
+*        buffer and runs done_fptr once the message is complete
+******************************************************************************/
+static uint8_t frag_rx_hook(void * const ctx, pckt_inst_t * const pckt_inst, pckt_view_t * const pckt_view)
+{
+	pckt_frag_t * const frag = (pckt_frag_t *)ctx;
+	const uint8_t * const payload = pckt_view->payload;
+	pckt_frag_stream_t *slot;
+	uint16_t id;
+	uint32_t total_len;
+	uint32_t offset;
+	uint16_t data_len;
+
+	(void)pckt_inst;
+
+	if(pckt_view->id != PCKT_FRAG_ID) return 0;
+
+	/*Too short to be a fragment*/
+	if(pckt_view->len < PCKT_FRAG_HDR_LEN) return 1;
+
+	id        = pckt_unsr_u16(&payload[ID_POS]);
+	total_len = pckt_unsr_u32(&payload[TOTAL_POS]);
+	offset    = pckt_unsr_u32(&payload[OFFSET_POS]);
+	data_len  = pckt_view->len - PCKT_FRAG_HDR_LEN;
+
+	slot = frag_find(frag, payload[STREAM_POS]);
+
+	if(offset == 0)
+	{
+		/*New message, one not finished on the same stream is lost*/
+		if(slot != 0)
+		{
+			frag_end(frag, slot, PCKT_FRAG_LOST);
+		}
+
+		slot = frag_start(frag, payload[STREAM_POS], id, total_len);
+		if(slot == 0) return 1;
+	}
+	else if((slot == 0) || (slot->id != id) || (slot->rx_len != offset))
+	{
+		/*Gap, the rest of the message is useless*/
+		if(slot != 0)
+		{
+			frag_end(frag, slot, PCKT_FRAG_LOST);
+		}
+
+		return 1;
+	}
+
+	if(data_len > (slot->total_len - slot->rx_len))
+	{
+		frag_end(frag, slot, PCKT_FRAG_LOST);
+		return 1;
+	}
+
+	/*Straight to its place in the message*/
+	memcpy(&slot->data[offset], &payload[PCKT_FRAG_HDR_LEN], data_len);
+	slot->rx_len += data_len;
+	slot->last_tick = pckt_get_tick(frag->pckt_inst);
+
+	if(slot->rx_len == slot->total_len)
+	{
+		frag_end(frag, slot, PCKT_FRAG_DONE);
+	}
+
+	return 1;
+}
+
+/******************************************************************************
+*  \brief Find active slot
+*
+*  \note returns slot receiving stream or 0
+******************************************************************************/
+static pckt_frag_stream_t *frag_find(pckt_frag_t * const frag, const uint8_t stream)
+{
+	uint8_t i;
+
+	for(i = 0; i < frag->num_streams; i++)
+	{
+		if(frag->streams[i].active && (frag->streams[i].stream == stream))
+		{
+			return &frag->streams[i];
+		}
+	}
+
+	return 0;
+}
+
+/******************************************************************************
+*  \brief Start message
+*
+*  \note takes a free slot and a buffer, returns 0 and reports the message
+*        lost if there is neither
+******************************************************************************/
+static pckt_frag_stream_t *frag_start(pckt_frag_t * const frag, const uint8_t stream, const uint16_t id, const uint32_t total_len)
+{
+	pckt_frag_stream_t *slot = 0;
+	uint8_t *data = 0;
+	uint8_t i;
+
+	for(i = 0; i < frag->num_streams; i++)
+	{
+		if(frag->streams[i].active == 0)
+		{
+			slot = &frag->streams[i];
+			break;
+		}
+	}
+
+	/*Buffer*/
+	if(slot != 0)
+	{
+		if(slot->pool_buf != 0)
+		{
+			data = (total_len <= frag->pool_buf_size) ? slot->pool_buf : 0;
+		}
+		else if(frag->alloc_fptr != 0)
+		{
+			data = frag->alloc_fptr(id, total_len);
+		}
+	}
+
+	if(data == 0)
+	{
+		frag->done_fptr(frag->pckt_inst, id, 0, 0, PCKT_FRAG_LOST);
+		return 0;
+	}
+
+	slot->data      = data;
+	slot->total_len = total_len;
+	slot->rx_len    = 0;
+	slot->id        = id;
+	slot->stream    = stream;
+	slot->active    = 1;
+	slot->last_tick = pckt_get_tick(frag->pckt_inst);
+
+	return slot;
+}
+
+/******************************************************************************
+*  \brief End message
+*
+*  \note frees the slot and hands the message to done_fptr, len is the bytes
+*        received
+******************************************************************************/
+static void frag_end(pckt_frag_t * const frag, pckt_frag_stream_t * const slot, const pckt_frag_status_t status)
+{
+	slot->active = 0;
+
+	frag->done_fptr(frag->pckt_inst, slot->id, slot->data, slot->rx_len, status);
+}
@@ -0,0 +1,117 @@
+/*
+ * pckt_frag.h
+ *
+ * Created: 10/16/2026
+ */
+
+/*
+ * Fragmentation and reassembly, sends messages bigger than one packet as numbered fragments
+ * under PCKT_FRAG_ID and rebuilds them on receive, one callback per complete message.
+ *
+ * HOW TO USE
+ * 1.DECLARE LAYER, STREAM SLOTS AND POOL MEMORY (ONE BUFFER PER SLOT)
+ * #define FRAG_STREAMS  4
+ * #define FRAG_MSG_SIZE 16384
+ * static uint8_t frag_pool[FRAG_STREAMS * FRAG_MSG_SIZE];
+ * static pckt_frag_stream_t frag_streams[FRAG_STREAMS];
+ * static pckt_frag_t frag;
+ *
+ * 2.INITIALIZE AND ATTACH TO AN INSTANCE, AFTER pckt_init()
+ * pckt_frag_init(&frag, frag_streams, FRAG_STREAMS, frag_pool, FRAG_MSG_SIZE, msg_done);
+ * pckt_frag_attach(&pckt_inst, &frag);
+ *
+ * 3.SEND AND RUN
+ * pckt_frag_tx(&pckt_inst, &frag, MSG_ID, data, len);
+ * pckt_task(&pckt_inst, cmd_handler);  //fragments never reach cmd_handler
+ * pckt_frag_task(&frag);               //drops messages that stopped arriving
+ *
+ * void msg_done(pckt_inst_t * const pckt_inst, const uint16_t id, uint8_t * const data, const uint32_t len, const pckt_frag_status_t status)
+ * {
+ *     if(status == PCKT_FRAG_DONE) ...use data, a pool buffer is reused after returning
+ * }
+ *
+ * Without a pool (pool = 0) set frag.alloc_fptr, it is asked for a buffer for each new message and
+ * the buffer is handed back through done_fptr, also when the message is dropped.
+ *
+ * FRAGMENT PAYLOAD
+ * [STREAM][ID:1, ID:0][TOTAL:3 ... TOTAL:0][OFFSET:3 ... OFFSET:0][DATA ...]
+ * STREAM tells interleaved messages apart, every fragment of a message has the same one.
+ * Fragments of a stream must arrive in order, a gap drops the message (PCKT_FRAG_LOST).
+ * Each fragment's DATA is copied straight to its offset in the message buffer.
+ * Needs a max payload of more than PCKT_FRAG_HDR_LEN bytes, see conf.rx_buffer.
+ */
+
+
+#ifndef PCKT_FRAG_H_
+#define PCKT_FRAG_H_
+
+
+#include "packet.h"
+
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#define PCKT_FRAG_ID      0xFFF0 //reserved packet ID of fragments
+#define PCKT_FRAG_HDR_LEN 11     //[STREAM][ID:1, ID:0][TOTAL:3 ... TOTAL:0][OFFSET:3 ... OFFSET:0]
+
+/*Message completion status*/
+typedef enum pckt_frag_status_t
+{
+	PCKT_FRAG_DONE,                      //all fragments received
+	PCKT_FRAG_LOST,                      //fragment missing or too big for the buffer, message dropped
+	PCKT_FRAG_TIMEOUT                    //no fragment for timeout, message dropped
+} pckt_frag_status_t;
+
+/*Reassembly slot, one message being received*/
+typedef struct pckt_frag_stream_t
+{
+	uint8_t *data;                       //message buffer, from the pool or alloc_fptr
+	uint8_t *pool_buf;                   //this slot's pool buffer, 0 without pool
+	uint32_t total_len;
+	uint32_t rx_len;                     //bytes received so far, also the next expected offset
+	uint16_t id;
+	uint8_t stream;
+	uint8_t active;
+	TICK_TYPE last_tick;                 //time last fragment was received
+} pckt_frag_stream_t;
+
+/*Transmit state of one message, see pckt_frag_tx_start()*/
+typedef struct pckt_frag_tx_t
+{
+	const uint8_t *data;
+	uint32_t len;
+	uint32_t offset;                     //next byte to send
+	uint16_t id;
+	uint8_t stream;
+	uint8_t busy;                        //fragments left to send
+} pckt_frag_tx_t;
+
+/*Fragmentation layer struct*/
+typedef struct pckt_frag_t
+{
+	pckt_frag_stream_t *streams;
+	uint8_t num_streams;
+	uint32_t pool_buf_size;              //size of each slot's pool buffer
+	uint8_t *(*alloc_fptr)(const uint16_t id, const uint32_t len); //buffer for a new message without pool, return 0 to drop it
+	void (*done_fptr)(pckt_inst_t * const, const uint16_t, uint8_t * const, const uint32_t, const pckt_frag_status_t); //instance, id, message, len, status
+	TICK_TYPE timeout;                   //drop a message after this long without a fragment
+	uint8_t tx_stream;                   //next STREAM used for sending
+	pckt_inst_t *pckt_inst;              //attached instance
+	pckt_rx_hook_t hook;
+} pckt_frag_t;
+
+
+/**************************************************************************************************
+*                                            PROTOTYPES
+*************************************************^************************************************/
+void     pckt_frag_init    (pckt_frag_t * const frag, pckt_frag_stream_t * const streams, const uint8_t num_streams, uint8_t * const pool, const uint32_t pool_buf_size, void (*done_fptr)(pckt_inst_t * const, const uint16_t, uint8_t * const, const uint32_t, const pckt_frag_status_t));
+int8_t   pckt_frag_attach  (pckt_inst_t * const pckt_inst, pckt_frag_t * const frag);
+void     pckt_frag_task    (pckt_frag_t * const frag);
+
+void     pckt_frag_tx_start(pckt_frag_t * const frag, pckt_frag_tx_t * const frag_tx, const uint16_t id, const uint8_t * const data, const uint32_t len);
+uint32_t pckt_frag_tx_next (pckt_inst_t * const pckt_inst, pckt_frag_tx_t * const frag_tx);
+void     pckt_frag_tx      (pckt_inst_t * const pckt_inst, pckt_frag_t * const frag, const uint16_t id, const uint8_t * const data, const uint32_t len);
+
+
+#endif /* PCKT_FRAG_H_ */
@@ -0,0 +1,116 @@
+/*
+ * pckt_msg.h
+ *
+ * Created: 10/16/2026
+ */
+
+/*
+ * Multi field messages described once with an X-macro. PCKT_MSG_DEFINE generates the struct,
+ * the payload length and inline pack/unpack/tx/rx functions, so a whole record goes out in one
+ * frame with one length check on receive.
+ *
+ * HOW TO USE
+ * 1.LIST THE FIELDS IN WIRE ORDER, X(type, name), type is u8 s8 u16 s16 u32 s32 flt32 u64 s64 dbl64
+ * #define SENSOR_REC_FIELDS(X) \
+ *     X(u32,   timestamp)       \
+ *     X(flt32, temperature)     \
+ *     X(s16,   accel_x)
+ *
+ * 2.DEFINE THE MESSAGE, at file scope in a header or .c
+ * PCKT_MSG_DEFINE(sensor_rec, SENSOR_REC_FIELDS)
+ *
+ * this gives
+ * sensor_rec_t                                         struct with the fields
+ * sensor_rec_LEN                                       payload length in bytes, 10 here
+ * sensor_rec_pack(uint8_t *dest, const sensor_rec_t *msg)
+ * sensor_rec_unpack(const uint8_t *src, sensor_rec_t *msg)
+ * sensor_rec_tx(pckt_inst_t *pckt_inst, uint16_t id, const sensor_rec_t *msg)  0, or -1 when too long for the instance
+ * sensor_rec_rx(pckt_inst_t *pckt_inst, sensor_rec_t *msg)  in the rx handler, same as pckt_rx_u32()
+ *
+ * A message with no fields or longer than MAX_PAYLOAD_LEN_BYTES fails to compile (negative array
+ * size in sensor_rec_len_chk). An instance with a smaller conf.rx_buffer has a smaller
+ * max_payload_len, sensor_rec_tx() sends nothing and returns -1 for a message longer than that.
+ */
+
+
+#ifndef PCKT_MSG_H_
+#define PCKT_MSG_H_
+
+
+#include "packet.h"
+#include "pckt_sr.h"
+
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+/*Field type tokens*/
+#define PCKT_MSG_TYPE_u8    uint8_t
+#define PCKT_MSG_TYPE_s8    int8_t
+#define PCKT_MSG_TYPE_u16   uint16_t
+#define PCKT_MSG_TYPE_s16   int16_t
+#define PCKT_MSG_TYPE_u32   uint32_t
+#define PCKT_MSG_TYPE_s32   int32_t
+#define PCKT_MSG_TYPE_flt32 float
+#define PCKT_MSG_TYPE_u64   uint64_t
+#define PCKT_MSG_TYPE_s64   int64_t
+#define PCKT_MSG_TYPE_dbl64 double
+
+/*Per field expansions*/
+#define PCKT_MSG_FIELD_(type, name)  PCKT_MSG_TYPE_##type name;
+#define PCKT_MSG_SIZE_(type, name)   + sizeof(PCKT_MSG_TYPE_##type)
+#define PCKT_MSG_PACK_(type, name)   pckt_sr_##type(dest_ptr, msg->name); dest_ptr += sizeof(PCKT_MSG_TYPE_##type);
+#define PCKT_MSG_UNPACK_(type, name) msg->name = pckt_unsr_##type(src_ptr); src_ptr += sizeof(PCKT_MSG_TYPE_##type);
+
+/*Message definition*/
+#define PCKT_MSG_DEFINE(name, FIELDS)                                                                  \
+typedef struct name##_t                                                                               \
+{                                                                                                     \
+	FIELDS(PCKT_MSG_FIELD_)                                                                           \
+} name##_t;                                                                                           \
+                                                                                                      \
+enum { name##_LEN = (0 FIELDS(PCKT_MSG_SIZE_)) };                                                      \
+                                                                                                      \
+typedef char name##_len_chk[((name##_LEN > 0) && (name##_LEN <= MAX_PAYLOAD_LEN_BYTES)) ? 1 : -1];    \
+                                                                                                      \
+static inline void name##_pack(uint8_t * const dest, const name##_t * const msg)                      \
+{                                                                                                     \
+	uint8_t *dest_ptr = dest;                                                                         \
+	FIELDS(PCKT_MSG_PACK_)                                                                            \
+	(void)dest_ptr;                                                                                   \
+}                                                                                                     \
+                                                                                                      \
+static inline void name##_unpack(const uint8_t * const src, name##_t * const msg)                     \
+{                                                                                                     \
+	const uint8_t *src_ptr = src;                                                                     \
+	FIELDS(PCKT_MSG_UNPACK_)                                                                          \
+	(void)src_ptr;                                                                                    \
+}                                                                                                     \
+                                                                                                      \
+static inline int8_t name##_tx(pckt_inst_t * const pckt_inst, const uint16_t id, const name##_t * const msg) \
+{                                                                                                     \
+	uint8_t pckt[name##_LEN];                                                                         \
+                                                                                                      \
+	if(name##_LEN > pckt_inst->max_payload_len) return -1;                                             \
+                                                                                                      \
+	name##_pack(pckt, msg);                                                                           \
+	pckt_tx_raw(pckt_inst, id, pckt, name##_LEN);                                                     \
+                                                                                                      \
+	return 0;                                                                                          \
+}                                                                                                     \
+                                                                                                      \
+static inline pckt_rx_valid_t name##_rx(pckt_inst_t * const pckt_inst, name##_t * const msg)          \
+{                                                                                                     \
+	if(pckt_inst->rx_view.len != name##_LEN)                                                          \
+	{                                                                                                 \
+		pckt_err_send(pckt_inst, PCKT_ERR_ID_RX_LEN);                                                 \
+		return PCKT_INVALID_LEN;                                                                      \
+	}                                                                                                 \
+                                                                                                      \
+	name##_unpack(pckt_inst->rx_view.payload, msg);                                                   \
+                                                                                                      \
+	return PCKT_VALID_LEN;                                                                            \
+}
+
+
+#endif /* PCKT_MSG_H_ */
@@ -0,0 +1,53 @@
+/*
+ * pckt_prof.c
+ *
+ * Created: 10/16/2026
+ */
+
+
+#include <string.h>
+
+#include "pckt_prof.h"
+
+/**************************************************************************************************
+*                                            VARIABLES
+*************************************************^************************************************/
+static const char * const stage_name[PCKT_PROF_STAGES] =
+{
+	"rx_read",
+	"rx_append",
+	"rx_crc",
+	"rx_copy",
+	"rx_handler",
+	"tx"
+};
+
+
+/**************************************************************************************************
+*                                            FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Profile reset
+*
+*  \note
+******************************************************************************/
+void pckt_prof_reset(pckt_prof_t * const prof)
+{
+	memset(prof, 0, sizeof(*prof));
+}
+
+/******************************************************************************
+*  \brief Profile dump
+*
+*  \note runs dump_fptr with the name and timing of each stage, no output of
+*        its own so it works without stdio
+******************************************************************************/
+void pckt_prof_dump(const pckt_prof_t * const prof, void (*dump_fptr)(const char * const, const pckt_prof_stage_t * const))
+{
+	uint8_t i;
+
+	for(i = 0; i < PCKT_PROF_STAGES; i++)
+	{
+		dump_fptr(stage_name[i], &prof->stage[i]);
+	}
+}
@@ -0,0 +1,178 @@
+/*
+ * pckt_prof.h
+ *
+ * Created: 10/16/2026
+ */
+
+/*
+ * Hot path profiling, times each stage of receiving and sending with a free running counter and
+ * keeps a log2 histogram per stage in the instance. Off by default, with PCKT_PROF_EN=0 nothing is
+ * compiled in.
+ *
+ * HOW TO USE
+ * 1.DEFINE PCKT_PROF_EN=1 FOR THE WHOLE PROJECT, see packet.h for where to put symbols
+ *
+ * 2.DUMP
+ * pckt_prof_dump(&pckt_inst.prof, prof_print);
+ *
+ * void prof_print(const char * const name, const pckt_prof_stage_t * const stage)
+ * {
+ *     printf("%s n=%lu avg=%lu max=%lu\n", name, stage->count, stage->total / stage->count, stage->max);
+ *     hist[n] counts stages that took 2^(n-1) to 2^n - 1 ticks, hist[0] the ones under 1
+ * }
+ *
+ * Only one run in PCKT_PROF_SAMPLE of each stage is timed, that keeps the cost low enough to
+ * leave on. count and hist are of the timed runs.
+ *
+ * TICKS are CPU cycles (rdtsc) on x86, nanoseconds (clock_gettime) on other POSIX hosts. Anything
+ * else, e.g. the DWT cycle counter of a Cortex-M, define PCKT_PROF_NOW() as an expression giving
+ * the counter. Stages nest, RX_HANDLER includes RX_COPY and any packet the handler sends, and TX
+ * is counted for every packet sent, also error replies.
+ */
+
+
+#ifndef PCKT_PROF_H_
+#define PCKT_PROF_H_
+
+
+#include <stdint.h>
+
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#ifndef PCKT_PROF_EN
+#define PCKT_PROF_EN 0 //per instance stage timing, see pckt_prof_dump(). Define PCKT_PROF_EN=1 to add it
+#endif
+
+#ifndef PCKT_PROF_SAMPLE
+#define PCKT_PROF_SAMPLE 16 //time one run in this many per stage, 1 to time every run. Reading the counter costs more than most stages
+#endif
+
+#ifndef PCKT_PROF_BUCKETS
+#define PCKT_PROF_BUCKETS 24 //log2 histogram buckets per stage, the last one also takes anything longer
+#endif
+
+#if PCKT_PROF_EN && !defined(PCKT_PROF_NOW)
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PCKT_PROF_NOW() ((pckt_prof_tick_t)__rdtsc())
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PCKT_PROF_NOW() ((pckt_prof_tick_t)__rdtsc())
+#else
+#include <time.h>
+#if defined(CLOCK_MONOTONIC)
+#define PCKT_PROF_NOW() pckt_prof_ns()
+#define PCKT_PROF_NS
+#else
+#error "PCKT_PROF_EN needs PCKT_PROF_NOW() defined as a free running counter on this target"
+#endif
+#endif
+#endif
+
+/*Stage tick count, differences of PCKT_PROF_NOW() wrap correctly*/
+typedef uint32_t pckt_prof_tick_t;
+
+/*Timed stages*/
+typedef enum pckt_prof_stage_id_t
+{
+	PCKT_PROF_RX_READ,                   //rx_byte_fptr or rx_block_fptr call
+	PCKT_PROF_RX_APPEND,                 //received bytes copied to the receive buffer
+	PCKT_PROF_RX_CRC,                    //crc of a received packet, or the running crc update
+	PCKT_PROF_RX_COPY,                   //payload copied to pckt_rx_t for the command handler
+	PCKT_PROF_RX_HANDLER,                //rx hooks and command handler
+	PCKT_PROF_TX,                        //building and sending a packet, pckt_tx_* functions
+	PCKT_PROF_STAGES
+} pckt_prof_stage_id_t;
+
+/*Stage timing*/
+typedef struct pckt_prof_stage_t
+{
+	uint32_t count;                      //timed runs of the stage
+	uint64_t total;                      //ticks of all runs
+	pckt_prof_tick_t max;                //ticks of the longest run
+	uint32_t hist[PCKT_PROF_BUCKETS];    //hist[n] counts runs of 2^(n-1) to 2^n - 1 ticks
+} pckt_prof_stage_t;
+
+/*Instance profile*/
+typedef struct pckt_prof_t
+{
+	pckt_prof_stage_t stage[PCKT_PROF_STAGES];
+	uint16_t skip[PCKT_PROF_STAGES];     //runs since the last timed one
+} pckt_prof_t;
+
+
+/**************************************************************************************************
+*                                            PROTOTYPES
+*************************************************^************************************************/
+void pckt_prof_reset(pckt_prof_t * const prof);
+void pckt_prof_dump (const pckt_prof_t * const prof, void (*dump_fptr)(const char * const, const pckt_prof_stage_t * const));
+
+
+/**************************************************************************************************
+*                                            FUNCTIONS
+*************************************************^************************************************/
+#ifdef PCKT_PROF_NS
+/******************************************************************************
+*  \brief Nanosecond counter
+*
+*  \note
+******************************************************************************/
+static inline pckt_prof_tick_t pckt_prof_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (pckt_prof_tick_t)((uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec);
+}
+#endif
+
+/******************************************************************************
+*  \brief Stage due
+*
+*  \note returns 1 if this run of the stage is to be timed
+******************************************************************************/
+static inline uint8_t pckt_prof_due(pckt_prof_t * const prof, const pckt_prof_stage_id_t stage_id)
+{
+	if(++prof->skip[stage_id] < PCKT_PROF_SAMPLE) return 0;
+
+	prof->skip[stage_id] = 0;
+
+	return 1;
+}
+
+/******************************************************************************
+*  \brief Add stage run
+*
+*  \note called by packet.c with the ticks one run of stage took
+******************************************************************************/
+static inline void pckt_prof_add(pckt_prof_t * const prof, const pckt_prof_stage_id_t stage_id, const pckt_prof_tick_t ticks)
+{
+	pckt_prof_stage_t * const stage = &prof->stage[stage_id];
+	uint8_t bucket = 0;
+	pckt_prof_tick_t rest = ticks;
+
+	/*Bucket is the bit length of ticks*/
+#if defined(__GNUC__)
+	if(rest > 0) bucket = (uint8_t)(32 - __builtin_clz(rest));
+#else
+	while(rest > 0)
+	{
+		bucket++;
+		rest >>= 1;
+	}
+#endif
+
+	if(bucket >= PCKT_PROF_BUCKETS) bucket = PCKT_PROF_BUCKETS - 1;
+
+	stage->count++;
+	stage->total += ticks;
+	stage->hist[bucket]++;
+
+	if(ticks > stage->max) stage->max = ticks;
+}
+
+
+#endif /* PCKT_PROF_H_ */
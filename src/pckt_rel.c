@@ -0,0 +1,418 @@
+/*
+ * pckt_rel.c
+ *
+ * Created: 10/16/2026
+ */
+
+
+#include <string.h>
+
+#include "pckt_rel.h"
+#include "pckt_sr.h"
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#define SEQ_POS      0
+#define ID_POS       1
+#define NEXT_POS     0
+#define SACK_POS     1
+#define SEQ_DIST(from, to) ((uint8_t)((uint8_t)(to) - (uint8_t)(from))) //steps from SEQ from to SEQ to, wraps at 256
+
+
+/**************************************************************************************************
+*                                         LOCAL PROTOTYPES
+*************************************************^************************************************/
+static uint8_t          rel_rx_hook (void * const ctx, pckt_inst_t * const pckt_inst, pckt_view_t * const pckt_view);
+static void             rel_rx_data (pckt_rel_t * const rel, pckt_view_t * const pckt_view);
+static void             rel_rx_ack  (pckt_rel_t * const rel, const pckt_view_t * const pckt_view);
+static void             rel_rx_nack (pckt_rel_t * const rel, const pckt_view_t * const pckt_view);
+static void             rel_deliver (pckt_rel_t * const rel, pckt_view_t * const pckt_view, const uint16_t id, const uint8_t * const payload, const uint16_t len);
+static void             rel_send    (pckt_rel_t * const rel, pckt_rel_slot_t * const slot);
+static void             rel_send_ack(pckt_rel_t * const rel);
+static pckt_rel_slot_t *rel_find    (pckt_rel_slot_t * const slots, const uint8_t window, const uint8_t seq);
+
+
+/**************************************************************************************************
+*                                            FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Reliable init
+*
+*  \note slots and pool hold 2 * window entries, the first half for sending and
+*        the second half for receiving. Timeout defaults to 200
+******************************************************************************/
+void pckt_rel_init(pckt_rel_t * const rel, pckt_rel_slot_t * const slots, const uint8_t window, uint8_t * const pool, const uint16_t slot_size, void (*rx_fptr)(pckt_inst_t * const, const pckt_view_t * const))
+{
+	uint8_t i;
+
+	rel->window = window;
+
+	if(rel->window > PCKT_REL_WINDOW_MAX) rel->window = PCKT_REL_WINDOW_MAX;
+	if(rel->window == 0)                  rel->window = 1;
+
+	for(i = 0; i < (2 * rel->window); i++)
+	{
+		slots[i].buf = &pool[i * slot_size];
+	}
+
+	rel->tx_slots   = &slots[0];
+	rel->rx_slots   = &slots[rel->window];
+	rel->slot_size  = slot_size;
+	rel->rx_fptr    = rx_fptr;
+	rel->timeout    = 200;
+	rel->retx_count = 0;
+	rel->pckt_inst  = 0;
+
+	pckt_rel_reset(rel);
+}
+
+/******************************************************************************
+*  \brief Reliable attach
+*
+*  \note adds the layer to the instance, returns 0 for success or -1 if the
+*        instance max payload can not hold a slot_size packet
+******************************************************************************/
+int8_t pckt_rel_attach(pckt_inst_t * const pckt_inst, pckt_rel_t * const rel)
+{
+	if(pckt_inst->max_payload_len < (rel->slot_size + PCKT_REL_HDR_LEN)) return -1;
+	if(pckt_inst->max_payload_len < PCKT_REL_ACK_LEN)                    return -1;
+
+	rel->pckt_inst = pckt_inst;
+	rel->hook.fptr = rel_rx_hook;
+	rel->hook.ctx  = rel;
+
+	pckt_rx_hook_add(pckt_inst, &rel->hook);
+
+	return 0;
+}
+
+/******************************************************************************
+*  \brief Reliable reset
+*
+*  \note drops every packet in flight or waiting and starts again at SEQ 0
+******************************************************************************/
+void pckt_rel_reset(pckt_rel_t * const rel)
+{
+	uint8_t i;
+
+	for(i = 0; i < rel->window; i++)
+	{
+		rel->tx_slots[i].used = 0;
+		rel->rx_slots[i].used = 0;
+	}
+
+	rel->tx_base   = 0;
+	rel->tx_next   = 0;
+	rel->rx_next   = 0;
+	rel->nack_seq  = 0;
+	rel->nack_sent = 0;
+}
+
+/******************************************************************************
+*  \brief Reliable task
+*
+*  \note retransmits every packet not acknowledged within timeout, call with
+*        pckt_task()
+******************************************************************************/
+void pckt_rel_task(pckt_rel_t * const rel)
+{
+	uint8_t i;
+
+	if(rel->pckt_inst == 0) return;
+
+	for(i = 0; i < rel->window; i++)
+	{
+		if(rel->tx_slots[i].used && (pckt_tick_elapsed(rel->pckt_inst, rel->tx_slots[i].last_tick) >= rel->timeout))
+		{
+			rel_send(rel, &rel->tx_slots[i]);
+			rel->retx_count++;
+		}
+	}
+}
+
+/******************************************************************************
+*  \brief Reliable TX
+*
+*  \note copies and sends the packet, returns 0 for success or -1 if the window
+*        is full or len is bigger than slot_size
+******************************************************************************/
+int8_t pckt_rel_tx(pckt_rel_t * const rel, const uint16_t id, const uint8_t * const data, const uint16_t len)
+{
+	pckt_rel_slot_t *slot = 0;
+	uint8_t i;
+
+	if((rel->pckt_inst == 0) || (len > rel->slot_size) || (pckt_rel_tx_free(rel) == 0)) return -1;
+
+	for(i = 0; i < rel->window; i++)
+	{
+		if(rel->tx_slots[i].used == 0)
+		{
+			slot = &rel->tx_slots[i];
+			break;
+		}
+	}
+
+	if(slot == 0) return -1;
+
+	memcpy(slot->buf, data, len);
+	slot->len  = len;
+	slot->id   = id;
+	slot->seq  = rel->tx_next++;
+	slot->used = 1;
+
+	rel_send(rel, slot);
+
+	return 0;
+}
+
+/******************************************************************************
+*  \brief Reliable TX free
+*
+*  \note returns how many packets pckt_rel_tx() takes before the window is full
+******************************************************************************/
+uint8_t pckt_rel_tx_free(const pckt_rel_t * const rel)
+{
+	return rel->window - SEQ_DIST(rel->tx_base, rel->tx_next);
+}
+
+
+/**************************************************************************************************
+*                                         LOCAL FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Reliable receive hook
+*
+*  \note takes PCKT_REL_ID packets and ACK/NACK packets of this layer's lengths
+******************************************************************************/
+static uint8_t rel_rx_hook(void * const ctx, pckt_inst_t * const pckt_inst, pckt_view_t * const pckt_view)
+{
+	pckt_rel_t * const rel = (pckt_rel_t *)ctx;
+
+	(void)pckt_inst;
+
+	switch(pckt_view->id)
+	{
+		case PCKT_REL_ID:
+			if(pckt_view->len >= PCKT_REL_HDR_LEN)
+			{
+				rel_rx_data(rel, pckt_view);
+			}
+			return 1;
+
+		case PCKT_ERR_ID_ACK:
+			if(pckt_view->len != PCKT_REL_ACK_LEN) return 0;
+			rel_rx_ack(rel, pckt_view);
+			return 1;
+
+		case PCKT_ERR_ID_NACK:
+			if(pckt_view->len != PCKT_REL_NACK_LEN) return 0;
+			rel_rx_nack(rel, pckt_view);
+			return 1;
+
+		default:
+			return 0;
+	}
+}
+
+/******************************************************************************
+*  \brief Received data
+*
+*  \note delivers the packet and any it unblocks, or keeps it until the gap
+*        before it is filled. Every data packet is acknowledged
+******************************************************************************/
+static void rel_rx_data(pckt_rel_t * const rel, pckt_view_t * const pckt_view)
+{
+	const uint8_t seq = pckt_view->payload[SEQ_POS];
+	const uint8_t dist = SEQ_DIST(rel->rx_next, seq);
+	const uint16_t id = pckt_unsr_u16(&pckt_view->payload[ID_POS]);
+	const uint16_t len = pckt_view->len - PCKT_REL_HDR_LEN;
+	pckt_rel_slot_t *slot;
+	uint8_t i;
+
+	if(dist == 0)
+	{
+		/*Next in order, straight from the receive buffer*/
+		rel_deliver(rel, pckt_view, id, &pckt_view->payload[PCKT_REL_HDR_LEN], len);
+
+		/*Then every packet it was holding up*/
+		while((slot = rel_find(rel->rx_slots, rel->window, rel->rx_next)) != 0)
+		{
+			slot->used = 0;
+			rel_deliver(rel, pckt_view, slot->id, slot->buf, slot->len);
+		}
+	}
+	else if((dist < rel->window) && (len <= rel->slot_size))
+	{
+		/*Ahead of a gap, keep a copy*/
+		if(rel_find(rel->rx_slots, rel->window, seq) == 0)
+		{
+			for(i = 0; i < rel->window; i++)
+			{
+				if(rel->rx_slots[i].used == 0)
+				{
+					slot = &rel->rx_slots[i];
+
+					memcpy(slot->buf, &pckt_view->payload[PCKT_REL_HDR_LEN], len);
+					slot->len  = len;
+					slot->id   = id;
+					slot->seq  = seq;
+					slot->used = 1;
+					break;
+				}
+			}
+		}
+
+		/*Ask for the missing one once*/
+		if((rel->nack_sent == 0) || (rel->nack_seq != rel->rx_next))
+		{
+			rel->nack_seq  = rel->rx_next;
+			rel->nack_sent = 1;
+			pckt_tx_raw(rel->pckt_inst, PCKT_ERR_ID_NACK, &rel->nack_seq, PCKT_REL_NACK_LEN);
+		}
+	}
+
+	/*Duplicates and packets past the window are only acknowledged, the ACK for them may have been lost*/
+	rel_send_ack(rel);
+}
+
+/******************************************************************************
+*  \brief Received ACK
+*
+*  \note frees every packet before NEXT_SEQ and every one flagged in SACK
+******************************************************************************/
+static void rel_rx_ack(pckt_rel_t * const rel, const pckt_view_t * const pckt_view)
+{
+	const uint8_t next = pckt_view->payload[NEXT_POS];
+	const uint32_t sack = pckt_unsr_u32(&pckt_view->payload[SACK_POS]);
+	const uint8_t acked = SEQ_DIST(rel->tx_base, next);
+	uint8_t dist;
+	uint8_t i;
+
+	/*Old or not sent yet*/
+	if(acked > SEQ_DIST(rel->tx_base, rel->tx_next)) return;
+
+	for(i = 0; i < rel->window; i++)
+	{
+		if(rel->tx_slots[i].used == 0) continue;
+
+		dist = SEQ_DIST(rel->tx_base, rel->tx_slots[i].seq);
+
+		if(dist < acked)
+		{
+			rel->tx_slots[i].used = 0;
+		}
+		else if((dist > acked) && (sack & ((uint32_t)1 << (dist - acked - 1))))
+		{
+			rel->tx_slots[i].used = 0;
+		}
+	}
+
+	rel->tx_base = next;
+}
+
+/******************************************************************************
+*  \brief Received NACK
+*
+*  \note retransmits SEQ now instead of at its timeout
+******************************************************************************/
+static void rel_rx_nack(pckt_rel_t * const rel, const pckt_view_t * const pckt_view)
+{
+	pckt_rel_slot_t * const slot = rel_find(rel->tx_slots, rel->window, pckt_view->payload[SEQ_POS]);
+
+	if(slot != 0)
+	{
+		rel_send(rel, slot);
+		rel->retx_count++;
+	}
+}
+
+/******************************************************************************
+*  \brief Deliver
+*
+*  \note runs rx_fptr with the unwrapped packet as the instance rx_view, so the
+*        pckt_rx_* functions work in it
+******************************************************************************/
+static void rel_deliver(pckt_rel_t * const rel, pckt_view_t * const pckt_view, const uint16_t id, const uint8_t * const payload, const uint16_t len)
+{
+	pckt_view->id      = id;
+	pckt_view->payload = payload;
+	pckt_view->len     = len;
+
+	rel->rx_next++;
+
+	if(rel->rx_fptr != 0)
+	{
+		rel->rx_fptr(rel->pckt_inst, pckt_view);
+	}
+}
+
+/******************************************************************************
+*  \brief Send
+*
+*  \note sends the slot packet and restarts its retransmit timeout
+******************************************************************************/
+static void rel_send(pckt_rel_t * const rel, pckt_rel_slot_t * const slot)
+{
+	uint8_t hdr[PCKT_REL_HDR_LEN];
+	pckt_tx_seg_t seg[2];
+
+	hdr[SEQ_POS] = slot->seq;
+	pckt_sr_u16(&hdr[ID_POS], slot->id);
+
+	seg[0].data = hdr;
+	seg[0].len  = sizeof(hdr);
+	seg[1].data = slot->buf;
+	seg[1].len  = slot->len;
+
+	pckt_tx_gather(rel->pckt_inst, PCKT_REL_ID, seg, 2);
+
+	slot->last_tick = pckt_get_tick(rel->pckt_inst);
+}
+
+/******************************************************************************
+*  \brief Send ACK
+*
+*  \note
+******************************************************************************/
+static void rel_send_ack(pckt_rel_t * const rel)
+{
+	uint8_t ack[PCKT_REL_ACK_LEN];
+	uint32_t sack = 0;
+	uint8_t dist;
+	uint8_t i;
+
+	for(i = 0; i < rel->window; i++)
+	{
+		if(rel->rx_slots[i].used)
+		{
+			dist = SEQ_DIST(rel->rx_next, rel->rx_slots[i].seq);
+			sack |= (uint32_t)1 << (dist - 1);
+		}
+	}
+
+	ack[NEXT_POS] = rel->rx_next;
+	pckt_sr_u32(&ack[SACK_POS], sack);
+
+	pckt_tx_raw(rel->pckt_inst, PCKT_ERR_ID_ACK, ack, sizeof(ack));
+}
+
+/******************************************************************************
+*  \brief Find slot
+*
+*  \note returns used slot holding seq or 0
+******************************************************************************/
+static pckt_rel_slot_t *rel_find(pckt_rel_slot_t * const slots, const uint8_t window, const uint8_t seq)
+{
+	uint8_t i;
+
+	for(i = 0; i < window; i++)
+	{
+		if(slots[i].used && (slots[i].seq == seq))
+		{
+			return &slots[i];
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * pckt_rel.h
+ *
+ * Created: 10/16/2026
+ */
+
+/*
+ * Reliable delivery, a sliding window of numbered packets that are retransmitted until the other
+ * end acknowledges them. Up to window packets are in flight at once instead of waiting for each
+ * answer, which is what keeps a high latency link busy.
+ *
+ * HOW TO USE
+ * 1.DECLARE LAYER, SLOTS AND POOL MEMORY (2 * WINDOW, FIRST HALF TX AND SECOND HALF RX)
+ * #define REL_WINDOW    8
+ * #define REL_SLOT_SIZE 32
+ * static uint8_t rel_pool[2 * REL_WINDOW * REL_SLOT_SIZE];
+ * static pckt_rel_slot_t rel_slots[2 * REL_WINDOW];
+ * static pckt_rel_t rel;
+ *
+ * 2.INITIALIZE AND ATTACH TO AN INSTANCE, AFTER pckt_init(), THE SAME WINDOW ON BOTH ENDS
+ * pckt_rel_init(&rel, rel_slots, REL_WINDOW, rel_pool, REL_SLOT_SIZE, rel_rx);
+ * pckt_rel_attach(&pckt_inst, &rel);
+ *
+ * 3.SEND AND RUN
+ * if(pckt_rel_tx(&rel, CMD_ID, data, len) != 0) ...window full, try again later
+ * pckt_task(&pckt_inst, cmd_handler);  //reliable packets and their ACK/NACK never reach cmd_handler
+ * pckt_rel_task(&rel);                 //retransmits packets not acknowledged within timeout
+ *
+ * void rel_rx(pckt_inst_t * const pckt_inst, const pckt_view_t * const pckt_view)
+ * {
+ *     ...called once per packet, in the order sent, pckt_rx_u32() etc. work here
+ * }
+ *
+ * DATA PAYLOAD, under PCKT_REL_ID
+ * [SEQ][ID:1, ID:0][PAYLOAD ...]
+ * ACK PAYLOAD, under PCKT_ERR_ID_ACK, sent for every data packet
+ * [NEXT_SEQ][SACK:3 ... SACK:0]  every SEQ before NEXT_SEQ arrived, SACK bit n set if NEXT_SEQ + 1 + n arrived
+ * NACK PAYLOAD, under PCKT_ERR_ID_NACK, sent once per gap
+ * [SEQ]                          SEQ is missing, sender retransmits it without waiting for timeout
+ *
+ * ACK/NACK packets of other lengths are passed on to the command handler as before. Both ends
+ * start at SEQ 0, call pckt_rel_reset() on both after a restart of either.
+ */
+
+
+#ifndef PCKT_REL_H_
+#define PCKT_REL_H_
+
+
+#include "packet.h"
+
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#define PCKT_REL_ID         0xFFF1 //reserved packet ID of reliable data
+#define PCKT_REL_HDR_LEN    3      //[SEQ][ID:1, ID:0]
+#define PCKT_REL_ACK_LEN    5      //[NEXT_SEQ][SACK:3 ... SACK:0]
+#define PCKT_REL_NACK_LEN   1      //[SEQ]
+#define PCKT_REL_WINDOW_MAX 32     //one SACK bit per packet after NEXT_SEQ
+
+/*Packet in flight or received out of order*/
+typedef struct pckt_rel_slot_t
+{
+	uint8_t *buf;                        //payload copy, slot_size bytes of the pool
+	uint16_t len;
+	uint16_t id;
+	uint8_t seq;
+	uint8_t used;
+	TICK_TYPE last_tick;                 //time packet was last sent
+} pckt_rel_slot_t;
+
+/*Reliable layer struct*/
+typedef struct pckt_rel_t
+{
+	pckt_rel_slot_t *tx_slots;           //window slots holding sent packets until acknowledged
+	pckt_rel_slot_t *rx_slots;           //window slots holding packets received ahead of a gap
+	uint8_t window;                      //max packets in flight, 1 to PCKT_REL_WINDOW_MAX
+	uint16_t slot_size;                  //max payload of a reliable packet
+	void (*rx_fptr)(pckt_inst_t * const, const pckt_view_t * const); //in order delivery of received packets
+	TICK_TYPE timeout;                   //retransmit a packet after this long without an ACK
+	uint8_t tx_base;                     //oldest SEQ not acknowledged
+	uint8_t tx_next;                     //SEQ of the next packet sent
+	uint8_t rx_next;                     //SEQ of the next packet delivered
+	uint8_t nack_seq;                    //last SEQ a NACK was sent for
+	uint8_t nack_sent;                   //nack_seq is valid
+	uint32_t retx_count;                 //number of retransmitted packets
+	pckt_inst_t *pckt_inst;              //attached instance
+	pckt_rx_hook_t hook;
+} pckt_rel_t;
+
+
+/**************************************************************************************************
+*                                            PROTOTYPES
+*************************************************^************************************************/
+void    pckt_rel_init   (pckt_rel_t * const rel, pckt_rel_slot_t * const slots, const uint8_t window, uint8_t * const pool, const uint16_t slot_size, void (*rx_fptr)(pckt_inst_t * const, const pckt_view_t * const));
+int8_t  pckt_rel_attach (pckt_inst_t * const pckt_inst, pckt_rel_t * const rel);
+void    pckt_rel_reset  (pckt_rel_t * const rel);
+void    pckt_rel_task   (pckt_rel_t * const rel);
+
+int8_t  pckt_rel_tx     (pckt_rel_t * const rel, const uint16_t id, const uint8_t * const data, const uint16_t len);
+uint8_t pckt_rel_tx_free(const pckt_rel_t * const rel);
+
+
+#endif /* PCKT_REL_H_ */
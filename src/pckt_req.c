@@ -0,0 +1,272 @@
+/*
+ * pckt_req.c
+ *
+ * Created: 10/16/2026
+ */
+
+
+#include "pckt_req.h"
+#include "pckt_sr.h"
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#define TOKEN_POS 0
+#define ID_POS    1
+
+
+/**************************************************************************************************
+*                                         LOCAL PROTOTYPES
+*************************************************^************************************************/
+static uint8_t          req_rx_hook(void * const ctx, pckt_inst_t * const pckt_inst, pckt_view_t * const pckt_view);
+static void             req_unwrap (pckt_view_t * const pckt_view);
+static void             req_send   (pckt_req_t * const req, const uint16_t wrap_id, const uint8_t token, const uint16_t id, const uint8_t * const data, const uint16_t len);
+static pckt_req_slot_t *req_find   (pckt_req_t * const req, const uint8_t token);
+
+
+/**************************************************************************************************
+*                                            FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Request init
+*
+*  \note num_slots is the max number of outstanding requests
+******************************************************************************/
+void pckt_req_init(pckt_req_t * const req, pckt_req_slot_t * const slots, const uint8_t num_slots)
+{
+	uint8_t i;
+
+	for(i = 0; i < num_slots; i++)
+	{
+		slots[i].used = 0;
+	}
+
+	req->slots          = slots;
+	req->num_slots      = num_slots;
+	req->next_token     = 0;
+	req->rx_token       = 0;
+	req->rx_token_valid = 0;
+	req->pckt_inst      = 0;
+}
+
+/******************************************************************************
+*  \brief Request attach
+*
+*  \note adds the layer to the instance, returns 0 for success or -1 if the
+*        instance max payload can not hold the request header
+******************************************************************************/
+int8_t pckt_req_attach(pckt_inst_t * const pckt_inst, pckt_req_t * const req)
+{
+	if(pckt_inst->max_payload_len < PCKT_REQ_HDR_LEN) return -1;
+
+	req->pckt_inst = pckt_inst;
+	req->hook.fptr = req_rx_hook;
+	req->hook.ctx  = req;
+
+	pckt_rx_hook_add(pckt_inst, &req->hook);
+
+	return 0;
+}
+
+/******************************************************************************
+*  \brief Request task
+*
+*  \note frees requests past their timeout and runs their callback with
+*        PCKT_REQ_TIMEOUT, call with pckt_task()
+******************************************************************************/
+void pckt_req_task(pckt_req_t * const req)
+{
+	pckt_req_slot_t *slot;
+	uint8_t i;
+
+	for(i = 0; i < req->num_slots; i++)
+	{
+		slot = &req->slots[i];
+
+		if(slot->used && (pckt_tick_elapsed(req->pckt_inst, slot->start_tick) >= slot->timeout))
+		{
+			slot->used = 0;
+			slot->done_fptr(req->pckt_inst, slot->ctx, PCKT_REQ_TIMEOUT, 0);
+		}
+	}
+}
+
+/******************************************************************************
+*  \brief Request send
+*
+*  \note sends id with a new token, done_fptr runs once with the reply or
+*        after timeout. Returns 0 for success or -1 if every slot is in use
+******************************************************************************/
+int8_t pckt_req_send(pckt_req_t * const req, const uint16_t id, const uint8_t * const data, const uint16_t len, const TICK_TYPE timeout, void (*done_fptr)(pckt_inst_t * const, void * const, const pckt_req_status_t, const pckt_view_t * const), void * const ctx)
+{
+	pckt_req_slot_t *slot = 0;
+	uint8_t i;
+
+	if((req->pckt_inst == 0) || (done_fptr == 0)) return -1;
+
+	for(i = 0; i < req->num_slots; i++)
+	{
+		if(req->slots[i].used == 0)
+		{
+			slot = &req->slots[i];
+			break;
+		}
+	}
+
+	if(slot == 0) return -1;
+
+	/*Skip tokens still waiting for a reply, there are fewer than 256 slots so one is free*/
+	while(req_find(req, req->next_token) != 0)
+	{
+		req->next_token++;
+	}
+
+	slot->done_fptr = done_fptr;
+	slot->ctx       = ctx;
+	slot->timeout   = timeout;
+	slot->token     = req->next_token++;
+	slot->used      = 1;
+	slot->start_tick = pckt_get_tick(req->pckt_inst);
+
+	req_send(req, PCKT_REQ_ID, slot->token, id, data, len);
+
+	return 0;
+}
+
+/******************************************************************************
+*  \brief Request reply
+*
+*  \note answers the request being handled, call from the command handler.
+*        Returns 0 for success or -1 if the packet was not a request or was
+*        already answered
+******************************************************************************/
+int8_t pckt_req_reply(pckt_req_t * const req, const uint16_t id, const uint8_t * const data, const uint16_t len)
+{
+	if(req->rx_token_valid == 0) return -1;
+
+	req->rx_token_valid = 0;
+
+	req_send(req, PCKT_RSP_ID, req->rx_token, id, data, len);
+
+	return 0;
+}
+
+/******************************************************************************
+*  \brief Request pending
+*
+*  \note returns the number of requests waiting for a reply
+******************************************************************************/
+uint8_t pckt_req_pending(const pckt_req_t * const req)
+{
+	uint8_t count = 0;
+	uint8_t i;
+
+	for(i = 0; i < req->num_slots; i++)
+	{
+		count += req->slots[i].used;
+	}
+
+	return count;
+}
+
+
+/**************************************************************************************************
+*                                         LOCAL FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Request receive hook
+*
+*  \note unwraps requests and passes them on to the command handler, takes
+*        replies and runs the callback of the request with their token
+******************************************************************************/
+static uint8_t req_rx_hook(void * const ctx, pckt_inst_t * const pckt_inst, pckt_view_t * const pckt_view)
+{
+	pckt_req_t * const req = (pckt_req_t *)ctx;
+	pckt_req_slot_t *slot;
+	uint8_t token;
+
+	/*Only the packet being handled can be replied to*/
+	req->rx_token_valid = 0;
+
+	if((pckt_view->id != PCKT_REQ_ID) && (pckt_view->id != PCKT_RSP_ID)) return 0;
+
+	/*Too short*/
+	if(pckt_view->len < PCKT_REQ_HDR_LEN) return 1;
+
+	token = pckt_view->payload[TOKEN_POS];
+
+	if(pckt_view->id == PCKT_REQ_ID)
+	{
+		req->rx_token       = token;
+		req->rx_token_valid = 1;
+
+		req_unwrap(pckt_view);
+
+		return 0;
+	}
+
+	/*Reply, a late one for a request already timed out is dropped*/
+	slot = req_find(req, token);
+
+	if(slot != 0)
+	{
+		slot->used = 0;
+		req_unwrap(pckt_view);
+		slot->done_fptr(pckt_inst, slot->ctx, PCKT_REQ_DONE, pckt_view);
+	}
+
+	return 1;
+}
+
+/******************************************************************************
+*  \brief Unwrap
+*
+*  \note rewrites the view to the wrapped ID and payload
+******************************************************************************/
+static void req_unwrap(pckt_view_t * const pckt_view)
+{
+	pckt_view->id       = pckt_unsr_u16(&pckt_view->payload[ID_POS]);
+	pckt_view->payload += PCKT_REQ_HDR_LEN;
+	pckt_view->len     -= PCKT_REQ_HDR_LEN;
+}
+
+/******************************************************************************
+*  \brief Send
+*
+*  \note
+******************************************************************************/
+static void req_send(pckt_req_t * const req, const uint16_t wrap_id, const uint8_t token, const uint16_t id, const uint8_t * const data, const uint16_t len)
+{
+	uint8_t hdr[PCKT_REQ_HDR_LEN];
+	pckt_tx_seg_t seg[2];
+
+	hdr[TOKEN_POS] = token;
+	pckt_sr_u16(&hdr[ID_POS], id);
+
+	seg[0].data = hdr;
+	seg[0].len  = sizeof(hdr);
+	seg[1].data = data;
+	seg[1].len  = len;
+
+	pckt_tx_gather(req->pckt_inst, wrap_id, seg, 2);
+}
+
+/******************************************************************************
+*  \brief Find request
+*
+*  \note returns the outstanding request with token or 0
+******************************************************************************/
+static pckt_req_slot_t *req_find(pckt_req_t * const req, const uint8_t token)
+{
+	uint8_t i;
+
+	for(i = 0; i < req->num_slots; i++)
+	{
+		if(req->slots[i].used && (req->slots[i].token == token))
+		{
+			return &req->slots[i];
+		}
+	}
+
+	return 0;
+}
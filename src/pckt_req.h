@@ -0,0 +1,98 @@
+/*
+ * pckt_req.h
+ *
+ * Created: 10/16/2026
+ */
+
+/*
+ * Request/response correlation, each request carries a token that the reply sends back, so many
+ * requests can be outstanding on one instance and each reply runs the callback of its request.
+ *
+ * HOW TO USE
+ * 1.DECLARE LAYER AND TABLE OF OUTSTANDING REQUESTS
+ * #define REQ_SLOTS 32
+ * static pckt_req_slot_t req_slots[REQ_SLOTS];
+ * static pckt_req_t req;
+ *
+ * 2.INITIALIZE AND ATTACH TO AN INSTANCE, AFTER pckt_init(), ON BOTH ENDS
+ * pckt_req_init(&req, req_slots, REQ_SLOTS);
+ * pckt_req_attach(&pckt_inst, &req);
+ *
+ * 3.REQUESTER
+ * if(pckt_req_send(&req, GET_TEMP_ID, 0, 0, 100, temp_done, &sensor) != 0) ...table full
+ * pckt_task(&pckt_inst, cmd_handler);
+ * pckt_req_task(&req);                 //runs the callback of requests past their timeout
+ *
+ * void temp_done(pckt_inst_t * const pckt_inst, void * const ctx, const pckt_req_status_t status, const pckt_view_t * const pckt_view)
+ * {
+ *     if(status == PCKT_REQ_DONE) ...pckt_view is the reply, pckt_rx_u32() etc. work here
+ * }
+ *
+ * 4.RESPONDER, requests reach the command handler with their own ID
+ * case GET_TEMP_ID:
+ *     pckt_sr_u32(buf, temp);
+ *     pckt_req_reply(&req, GET_TEMP_ID, buf, sizeof(buf)); //instead of pckt_tx_raw()
+ *
+ * REQUEST AND REPLY PAYLOAD, under PCKT_REQ_ID and PCKT_RSP_ID
+ * [TOKEN][ID:1, ID:0][PAYLOAD ...]
+ */
+
+
+#ifndef PCKT_REQ_H_
+#define PCKT_REQ_H_
+
+
+#include "packet.h"
+
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#define PCKT_REQ_ID      0xFFF2 //reserved packet ID of requests
+#define PCKT_RSP_ID      0xFFF3 //reserved packet ID of replies
+#define PCKT_REQ_HDR_LEN 3      //[TOKEN][ID:1, ID:0]
+
+/*Request completion status*/
+typedef enum pckt_req_status_t
+{
+	PCKT_REQ_DONE,                       //reply received
+	PCKT_REQ_TIMEOUT                     //no reply within timeout
+} pckt_req_status_t;
+
+/*Outstanding request*/
+typedef struct pckt_req_slot_t
+{
+	void (*done_fptr)(pckt_inst_t * const, void * const, const pckt_req_status_t, const pckt_view_t * const); //instance, ctx, status and reply (0 on timeout)
+	void *ctx;                           //passed to done_fptr
+	TICK_TYPE start_tick;                //time request was sent
+	TICK_TYPE timeout;
+	uint8_t token;
+	uint8_t used;
+} pckt_req_slot_t;
+
+/*Request layer struct*/
+typedef struct pckt_req_t
+{
+	pckt_req_slot_t *slots;
+	uint8_t num_slots;
+	uint8_t next_token;                  //token of the next request sent
+	uint8_t rx_token;                    //token of the request being handled, for pckt_req_reply()
+	uint8_t rx_token_valid;
+	pckt_inst_t *pckt_inst;              //attached instance
+	pckt_rx_hook_t hook;
+} pckt_req_t;
+
+
+/**************************************************************************************************
+*                                            PROTOTYPES
+*************************************************^************************************************/
+void    pckt_req_init  (pckt_req_t * const req, pckt_req_slot_t * const slots, const uint8_t num_slots);
+int8_t  pckt_req_attach(pckt_inst_t * const pckt_inst, pckt_req_t * const req);
+void    pckt_req_task  (pckt_req_t * const req);
+
+int8_t  pckt_req_send  (pckt_req_t * const req, const uint16_t id, const uint8_t * const data, const uint16_t len, const TICK_TYPE timeout, void (*done_fptr)(pckt_inst_t * const, void * const, const pckt_req_status_t, const pckt_view_t * const), void * const ctx);
+int8_t  pckt_req_reply (pckt_req_t * const req, const uint16_t id, const uint8_t * const data, const uint16_t len);
+uint8_t pckt_req_pending(const pckt_req_t * const req);
+
+
+#endif /* PCKT_REQ_H_ */
@@ -0,0 +1,337 @@
+/*
+ * pckt_sr.h
+ *
+ * Created: 10/16/2026
+ */
+
+/*
+ * Big endian serialize/unserialize helpers, the same wire format the pckt_tx_* and pckt_rx_*
+ * functions use. Everything is static inline so the conversion folds into the caller.
+ *
+ * HOW TO USE
+ * uint8_t buf[sizeof(uint32_t) + sizeof(float)];
+ * pckt_sr_u32(&buf[0], 1234);
+ * pckt_sr_flt32(&buf[4], 1.5f);
+ * pckt_tx_raw(&pckt_inst, ID, buf, sizeof(buf));
+ *
+ * and in the handler
+ * value = pckt_unsr_u32(&pckt_view->payload[0]);
+ *
+ * On little endian hosts a value is one load/store plus a byte swap builtin, on big endian hosts
+ * just the load/store. Unknown compilers get the portable shift version.
+ */
+
+
+#ifndef PCKT_SR_H_
+#define PCKT_SR_H_
+
+
+#include <stdint.h>
+#include <string.h>
+
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#if defined(__GNUC__) && defined(__BYTE_ORDER__)
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define PCKT_SR_BSWAP_16(x) __builtin_bswap16(x)
+#define PCKT_SR_BSWAP_32(x) __builtin_bswap32(x)
+#define PCKT_SR_BSWAP_64(x) __builtin_bswap64(x)
+#elif (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define PCKT_SR_BSWAP_16(x) (x)
+#define PCKT_SR_BSWAP_32(x) (x)
+#define PCKT_SR_BSWAP_64(x) (x)
+#endif
+#elif defined(_MSC_VER)
+#include <stdlib.h>
+#define PCKT_SR_BSWAP_16(x) _byteswap_ushort(x)
+#define PCKT_SR_BSWAP_32(x) _byteswap_ulong(x)
+#define PCKT_SR_BSWAP_64(x) _byteswap_uint64(x)
+#endif
+
+/**************************************************************************************************
+*                                            TYPEDEFS
+*************************************************^************************************************/
+typedef union bit8_dat_t
+{
+	uint8_t _uint;
+	int8_t _int;
+} bit8_dat_t;
+
+typedef union bit16_dat_t
+{
+	uint16_t _uint;
+	int16_t _int;
+} bit16_dat_t;
+
+typedef union bit32_dat_t
+{
+	uint32_t _uint;
+	int32_t _int;
+	float _flt;
+} bit32_dat_t;
+
+typedef union bit64_dat_t
+{
+	uint64_t _uint;
+	int64_t _int;
+	double _dbl;
+} bit64_dat_t;
+
+/**************************************************************************************************
+*                                            FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief 8BIT, no byte order, here so every packet type has a helper
+*
+*  \note
+******************************************************************************/
+static inline void pckt_sr_u8(uint8_t * const dest, const uint8_t src)
+{
+	dest[0] = src;
+}
+
+static inline void pckt_sr_s8(uint8_t * const dest, const int8_t src)
+{
+	bit8_dat_t bit8_dat;
+
+	bit8_dat._int = src;
+	dest[0] = bit8_dat._uint;
+}
+
+static inline uint8_t pckt_unsr_u8(const uint8_t * const big_endian_data)
+{
+	return big_endian_data[0];
+}
+
+static inline int8_t pckt_unsr_s8(const uint8_t * const big_endian_data)
+{
+	bit8_dat_t bit8_dat;
+
+	bit8_dat._uint = big_endian_data[0];
+
+	return bit8_dat._int;
+}
+
+/******************************************************************************
+*  \brief Serialize unsigned 16BIT, big endian
+*
+*  \note
+******************************************************************************/
+static inline void pckt_sr_u16(uint8_t * const dest, const uint16_t src)
+{
+#ifdef PCKT_SR_BSWAP_16
+	const uint16_t big_endian = PCKT_SR_BSWAP_16(src);
+
+	memcpy(dest, &big_endian, sizeof(big_endian));
+#else
+	dest[0] = (uint8_t)(src >> 8);
+	dest[1] = (uint8_t)src;
+#endif
+}
+
+/******************************************************************************
+*  \brief Serialize unsigned 32BIT, big endian
+*
+*  \note
+******************************************************************************/
+static inline void pckt_sr_u32(uint8_t * const dest, const uint32_t src)
+{
+#ifdef PCKT_SR_BSWAP_32
+	const uint32_t big_endian = PCKT_SR_BSWAP_32(src);
+
+	memcpy(dest, &big_endian, sizeof(big_endian));
+#else
+	uint8_t i;
+
+	for(i = 0; i < sizeof(src); i++)
+	{
+		dest[i] = (uint8_t)(src >> (sizeof(src) - 1 - i) * 8);
+	}
+#endif
+}
+
+/******************************************************************************
+*  \brief Serialize unsigned 64BIT, big endian
+*
+*  \note
+******************************************************************************/
+static inline void pckt_sr_u64(uint8_t * const dest, const uint64_t src)
+{
+#ifdef PCKT_SR_BSWAP_64
+	const uint64_t big_endian = PCKT_SR_BSWAP_64(src);
+
+	memcpy(dest, &big_endian, sizeof(big_endian));
+#else
+	uint8_t i;
+
+	for(i = 0; i < sizeof(src); i++)
+	{
+		dest[i] = (uint8_t)(src >> (sizeof(src) - 1 - i) * 8);
+	}
+#endif
+}
+
+/******************************************************************************
+*  \brief Unserialize unsigned 16BIT, big endian
+*
+*  \note
+******************************************************************************/
+static inline uint16_t pckt_unsr_u16(const uint8_t * const big_endian_data)
+{
+#ifdef PCKT_SR_BSWAP_16
+	uint16_t big_endian;
+
+	memcpy(&big_endian, big_endian_data, sizeof(big_endian));
+
+	return PCKT_SR_BSWAP_16(big_endian);
+#else
+	return (uint16_t)(((uint16_t)big_endian_data[0] << 8) | big_endian_data[1]);
+#endif
+}
+
+/******************************************************************************
+*  \brief Unserialize unsigned 32BIT, big endian
+*
+*  \note
+******************************************************************************/
+static inline uint32_t pckt_unsr_u32(const uint8_t * const big_endian_data)
+{
+#ifdef PCKT_SR_BSWAP_32
+	uint32_t big_endian;
+
+	memcpy(&big_endian, big_endian_data, sizeof(big_endian));
+
+	return PCKT_SR_BSWAP_32(big_endian);
+#else
+	uint8_t i;
+	uint32_t dat = 0;
+
+	for(i = 0; i < sizeof(dat); i++)
+	{
+		dat |= ((uint32_t)big_endian_data[i] << (sizeof(dat) - 1 - i) * 8);
+	}
+
+	return dat;
+#endif
+}
+
+/******************************************************************************
+*  \brief Unserialize unsigned 64BIT, big endian
+*
+*  \note
+******************************************************************************/
+static inline uint64_t pckt_unsr_u64(const uint8_t * const big_endian_data)
+{
+#ifdef PCKT_SR_BSWAP_64
+	uint64_t big_endian;
+
+	memcpy(&big_endian, big_endian_data, sizeof(big_endian));
+
+	return PCKT_SR_BSWAP_64(big_endian);
+#else
+	uint8_t i;
+	uint64_t dat = 0;
+
+	for(i = 0; i < sizeof(dat); i++)
+	{
+		dat |= ((uint64_t)big_endian_data[i] << (sizeof(dat) - 1 - i) * 8);
+	}
+
+	return dat;
+#endif
+}
+
+/******************************************************************************
+*  \brief Signed and floating point versions, same bits as the unsigned ones
+*
+*  \note
+******************************************************************************/
+static inline void pckt_sr_s16(uint8_t * const dest, const int16_t src)
+{
+	bit16_dat_t bit16_dat;
+
+	bit16_dat._int = src;
+	pckt_sr_u16(dest, bit16_dat._uint);
+}
+
+static inline void pckt_sr_s32(uint8_t * const dest, const int32_t src)
+{
+	bit32_dat_t bit32_dat;
+
+	bit32_dat._int = src;
+	pckt_sr_u32(dest, bit32_dat._uint);
+}
+
+static inline void pckt_sr_flt32(uint8_t * const dest, const float src)
+{
+	bit32_dat_t bit32_dat;
+
+	bit32_dat._flt = src;
+	pckt_sr_u32(dest, bit32_dat._uint);
+}
+
+static inline void pckt_sr_s64(uint8_t * const dest, const int64_t src)
+{
+	bit64_dat_t bit64_dat;
+
+	bit64_dat._int = src;
+	pckt_sr_u64(dest, bit64_dat._uint);
+}
+
+static inline void pckt_sr_dbl64(uint8_t * const dest, const double src)
+{
+	bit64_dat_t bit64_dat;
+
+	bit64_dat._dbl = src;
+	pckt_sr_u64(dest, bit64_dat._uint);
+}
+
+static inline int16_t pckt_unsr_s16(const uint8_t * const big_endian_data)
+{
+	bit16_dat_t bit16_dat;
+
+	bit16_dat._uint = pckt_unsr_u16(big_endian_data);
+
+	return bit16_dat._int;
+}
+
+static inline int32_t pckt_unsr_s32(const uint8_t * const big_endian_data)
+{
+	bit32_dat_t bit32_dat;
+
+	bit32_dat._uint = pckt_unsr_u32(big_endian_data);
+
+	return bit32_dat._int;
+}
+
+static inline float pckt_unsr_flt32(const uint8_t * const big_endian_data)
+{
+	bit32_dat_t bit32_dat;
+
+	bit32_dat._uint = pckt_unsr_u32(big_endian_data);
+
+	return bit32_dat._flt;
+}
+
+static inline int64_t pckt_unsr_s64(const uint8_t * const big_endian_data)
+{
+	bit64_dat_t bit64_dat;
+
+	bit64_dat._uint = pckt_unsr_u64(big_endian_data);
+
+	return bit64_dat._int;
+}
+
+static inline double pckt_unsr_dbl64(const uint8_t * const big_endian_data)
+{
+	bit64_dat_t bit64_dat;
+
+	bit64_dat._uint = pckt_unsr_u64(big_endian_data);
+
+	return bit64_dat._dbl;
+}
+
+
+#endif /* PCKT_SR_H_ */
@@ -6,6 +6,8 @@
  */
 
 
+#include <string.h>
+
 #include "ring_buffer.h"
 
 
@@ -32,6 +34,23 @@
  * ring_buffer_put_data(&uart_rx_buffer, data);
  * data = ring_buffer_get_data(&uart_rx_buffer);
  *
+ * 5.OR MOVE BLOCKS, AT MOST TWO memcpy EACH
+ * ring_buffer_write(&uart_tx_buffer, data_array, len);
+ * len = ring_buffer_read(&uart_rx_buffer, data_array, sizeof(data_array));
+ *
+ * 6.OR WORK ON RING MEMORY DIRECTLY, E.G. read() INTO IT OR PARSE FROM IT
+ * len = ring_buffer_peek_write(&uart_rx_buffer, &ptr);
+ * len = read(fd, ptr, len);
+ * ring_buffer_commit_write(&uart_rx_buffer, len);
+ *
+ * len = ring_buffer_peek_read(&uart_rx_buffer, &ptr);
+ * pckt_feed(&pckt_inst, ptr, len, cmd_handler);
+ * ring_buffer_commit_read(&uart_rx_buffer, len);
+ *
+ * PEEK AND COMMIT ONLY SEE THE CONTIGUOUS PART UP TO THE END OF THE ARRAY,
+ * CALL AGAIN AFTER COMMIT FOR THE WRAPPED PART. COMMIT WRITE NEVER THROWS
+ * OUT OLD DATA.
+ *
  *****************************************************************************/
 
 
@@ -39,6 +58,7 @@
 *                                         LOCAL PROTOTYPES
 *************************************************^************************************************/
 static inline void set_peak_usage(ring_buffer_t * const ring_buffer, const uint16_t usage);
+static inline uint16_t wrap_add   (const ring_buffer_t * const ring_buffer, const uint16_t ind, const uint16_t len);
 
 
 /**************************************************************************************************
@@ -165,6 +185,180 @@ uint16_t ring_buffer_get_max_usage(ring_buffer_t * const ring_buffer)
 }
 
 
+/******************************************************************************
+*  \brief Write data array into buffer
+*
+*  \note Same as ring_buffer_put_data() for each byte: returns 0 for no error
+*        and -1 for buffer overflow where oldest data was dumped
+******************************************************************************/
+int8_t ring_buffer_write(ring_buffer_t * const ring_buffer, const uint8_t * data, uint16_t len)
+{
+	int8_t overflow_flag = 0;
+	uint16_t usage = ring_buffer_get_usage(ring_buffer);
+	uint16_t head = ring_buffer->rb_head;
+	uint16_t first_len;
+
+	if(len == 0) return 0;
+
+	/*Check overflow*/
+	if(((uint32_t)usage + len) > ring_buffer->rb_buffer_size)
+	{
+		overflow_flag = -1;
+	}
+
+	/*Only the newest rb_buffer_size bytes can fit*/
+	if(len > ring_buffer->rb_buffer_size)
+	{
+		data += len - ring_buffer->rb_buffer_size;
+		len   = ring_buffer->rb_buffer_size;
+	}
+
+	/*Copy up to the end of the array then the rest from the start*/
+	first_len = ring_buffer->rb_buffer_size - head;
+	if(first_len > len) first_len = len;
+
+	memcpy((uint8_t *)&ring_buffer->rb_buffer_array[head], data, first_len);
+	memcpy((uint8_t *)ring_buffer->rb_buffer_array, data + first_len, len - first_len);
+
+	ring_buffer->rb_head  = wrap_add(ring_buffer, head, len);
+	ring_buffer->rb_state = BUFFER_HAS_DATA;
+
+	if(overflow_flag != 0)
+	{
+		/*this dumps oldest data, buffer is full*/
+		ring_buffer->rb_tail = ring_buffer->rb_head;
+		set_peak_usage(ring_buffer, ring_buffer->rb_buffer_size);
+	}
+	else
+	{
+		set_peak_usage(ring_buffer, usage + len);
+	}
+
+	return overflow_flag;
+}
+
+/******************************************************************************
+*  \brief Read data array from buffer
+*
+*  \note Reads up to len bytes, returns number of bytes read
+******************************************************************************/
+uint16_t ring_buffer_read(ring_buffer_t * const ring_buffer, uint8_t * const data, const uint16_t len)
+{
+	uint16_t read_len = ring_buffer_get_usage(ring_buffer);
+	uint16_t tail = ring_buffer->rb_tail;
+	uint16_t first_len;
+
+	if(read_len > len) read_len = len;
+
+	/*Copy up to the end of the array then the rest from the start*/
+	first_len = ring_buffer->rb_buffer_size - tail;
+	if(first_len > read_len) first_len = read_len;
+
+	memcpy(data, (const uint8_t *)&ring_buffer->rb_buffer_array[tail], first_len);
+	memcpy(data + first_len, (const uint8_t *)ring_buffer->rb_buffer_array, read_len - first_len);
+
+	ring_buffer_commit_read(ring_buffer, read_len);
+
+	return read_len;
+}
+
+/******************************************************************************
+*  \brief Get ring buffer usage
+*
+*  \note returns number of bytes in the buffer
+******************************************************************************/
+uint16_t ring_buffer_get_usage(ring_buffer_t * const ring_buffer)
+{
+	if(ring_buffer->rb_state == BUFFER_EMPTY) return 0;
+
+	if(ring_buffer->rb_head > ring_buffer->rb_tail)
+	{
+		/*head > tail*/
+		return ring_buffer->rb_head - ring_buffer->rb_tail;
+	}
+
+	/*head <= tail, head == tail is full*/
+	return (uint16_t)(((uint32_t)ring_buffer->rb_head + (uint32_t)ring_buffer->rb_buffer_size) - ring_buffer->rb_tail);
+}
+
+/******************************************************************************
+*  \brief Peek readable data
+*
+*  \note Points data at the oldest byte, returns number of bytes readable
+*        there without wrapping. Follow with ring_buffer_commit_read()
+******************************************************************************/
+uint16_t ring_buffer_peek_read(ring_buffer_t * const ring_buffer, uint8_t ** const data)
+{
+	uint16_t len = ring_buffer_get_usage(ring_buffer);
+	uint16_t tail = ring_buffer->rb_tail;
+
+	*data = (uint8_t *)&ring_buffer->rb_buffer_array[tail];
+
+	if(len > (ring_buffer->rb_buffer_size - tail))
+	{
+		len = ring_buffer->rb_buffer_size - tail;
+	}
+
+	return len;
+}
+
+/******************************************************************************
+*  \brief Commit read data
+*
+*  \note Removes len bytes from the buffer, len must not be more than the
+*        buffer holds
+******************************************************************************/
+void ring_buffer_commit_read(ring_buffer_t * const ring_buffer, const uint16_t len)
+{
+	if(len == 0) return;
+
+	ring_buffer->rb_tail = wrap_add(ring_buffer, ring_buffer->rb_tail, len);
+
+	/*check if buffer is empty*/
+	if(ring_buffer->rb_head == ring_buffer->rb_tail)
+	{
+		ring_buffer->rb_state = BUFFER_EMPTY;
+	}
+}
+
+/******************************************************************************
+*  \brief Peek writable space
+*
+*  \note Points data at the next free byte, returns number of free bytes
+*        there without wrapping. Follow with ring_buffer_commit_write()
+******************************************************************************/
+uint16_t ring_buffer_peek_write(ring_buffer_t * const ring_buffer, uint8_t ** const data)
+{
+	uint16_t len = ring_buffer->rb_buffer_size - ring_buffer_get_usage(ring_buffer);
+	uint16_t head = ring_buffer->rb_head;
+
+	*data = (uint8_t *)&ring_buffer->rb_buffer_array[head];
+
+	if(len > (ring_buffer->rb_buffer_size - head))
+	{
+		len = ring_buffer->rb_buffer_size - head;
+	}
+
+	return len;
+}
+
+/******************************************************************************
+*  \brief Commit written data
+*
+*  \note Adds len bytes written at the peek pointer, len must not be more
+*        than ring_buffer_peek_write() returned
+******************************************************************************/
+void ring_buffer_commit_write(ring_buffer_t * const ring_buffer, const uint16_t len)
+{
+	if(len == 0) return;
+
+	ring_buffer->rb_head  = wrap_add(ring_buffer, ring_buffer->rb_head, len);
+	ring_buffer->rb_state = BUFFER_HAS_DATA;
+
+	set_peak_usage(ring_buffer, ring_buffer_get_usage(ring_buffer));
+}
+
+
 /**************************************************************************************************
 *                                         LOCAL FUNCTIONS
 *************************************************^************************************************/
@@ -178,3 +372,18 @@ static inline void set_peak_usage(ring_buffer_t * const ring_buffer, const uint1
     if(usage > ring_buffer->rb_max_usage)
         ring_buffer->rb_max_usage = usage;
 }
+
+/******************************************************************************
+*  \brief Wrapping add to head or tail
+*
+*  \note len must not be more than rb_buffer_size
+******************************************************************************/
+static inline uint16_t wrap_add(const ring_buffer_t * const ring_buffer, const uint16_t ind, const uint16_t len)
+{
+	uint32_t sum = (uint32_t)ind + len;
+
+	if(sum >= ring_buffer->rb_buffer_size)
+		sum -= ring_buffer->rb_buffer_size;
+
+	return (uint16_t)sum;
+}
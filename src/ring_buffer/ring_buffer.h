@@ -41,5 +41,13 @@ int8_t   ring_buffer_put_data     (ring_buffer_t * const ring_buffer, const uint
 int16_t  ring_buffer_get_data     (ring_buffer_t * const ring_buffer);
 uint16_t ring_buffer_get_max_usage(ring_buffer_t * const ring_buffer);
 
+int8_t   ring_buffer_write        (ring_buffer_t * const ring_buffer, const uint8_t * data, uint16_t len);
+uint16_t ring_buffer_read         (ring_buffer_t * const ring_buffer, uint8_t * const data, const uint16_t len);
+uint16_t ring_buffer_get_usage    (ring_buffer_t * const ring_buffer);
+uint16_t ring_buffer_peek_read    (ring_buffer_t * const ring_buffer, uint8_t ** const data);
+void     ring_buffer_commit_read  (ring_buffer_t * const ring_buffer, const uint16_t len);
+uint16_t ring_buffer_peek_write   (ring_buffer_t * const ring_buffer, uint8_t ** const data);
+void     ring_buffer_commit_write (ring_buffer_t * const ring_buffer, const uint16_t len);
+
 
 #endif /* RING_BUFFER_H_ */
@@ -0,0 +1,285 @@
+/*
+ * spsc_ring_buffer.c
+ *
+ * Created: 10/16/2026
+ */
+
+
+#include <string.h>
+
+#include "spsc_ring_buffer.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+/******************************************************************************
+ * SINGLE PRODUCER SINGLE CONSUMER RING BUFFER, NO LOCKS
+ * ONE THREAD (OR ISR) PUTS AND ONE THREAD GETS, E.G. A UART READER THREAD
+ * FEEDING pckt_task().
+ *
+ * UNLIKE ring_buffer THIS ONE DOES NOT THROW OUT OLD DATA WHEN FULL, THE
+ * PRODUCER CAN NOT MOVE THE TAIL WITHOUT RACING THE CONSUMER. PUT RETURNS -1
+ * AND THE NEW DATA IS DROPPED.
+ *
+ * HOW TO USE
+ *
+ * 1.DECLARE BUFFER MEMORY, SIZE MUST BE A POWER OF TWO
+ * #define UART_RING_BUFFER_SIZE_BYTE 1024
+ * uint8_t uart_rx_array[UART_RING_BUFFER_SIZE_BYTE];
+ *
+ * 2.DECLARE RING BUFFER STRUCT
+ * spsc_ring_buffer_t uart_rx_buffer;
+ *
+ * 3.INITIALIZE RING BUFFER STRUCT, RETURNS -1 IF SIZE IS NOT A POWER OF TWO
+ * spsc_ring_buffer_init(&uart_rx_buffer, uart_rx_array, UART_RING_BUFFER_SIZE_BYTE);
+ *
+ * 4.PUT FROM THE PRODUCER, GET FROM THE CONSUMER
+ * spsc_ring_buffer_put_data(&uart_rx_buffer, data);
+ * data = spsc_ring_buffer_get_data(&uart_rx_buffer);
+ *
+ * 5.OR MOVE BLOCKS, AT MOST TWO memcpy EACH
+ * len = spsc_ring_buffer_write(&uart_rx_buffer, data_array, len);
+ * len = spsc_ring_buffer_read(&uart_rx_buffer, data_array, sizeof(data_array));
+ *
+ * Head and tail count up forever and are masked into the array, the
+ * difference is the number of bytes in the buffer. Each index is on its own
+ * cache line so the two threads do not share a line they write.
+ *
+ *****************************************************************************/
+
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+/*Index access, C11 atomics or with MSVC volatile and barriers. x86 and x64 keep loads before later
+ *accesses and stores after earlier ones so only the compiler must not move them, ARM needs dmb*/
+#if defined(_MSC_VER)
+#if defined(_M_ARM64)
+#define SPSC_FENCE()               __dmb(_ARM64_BARRIER_ISH)
+#elif defined(_M_ARM)
+#define SPSC_FENCE()               __dmb(_ARM_BARRIER_ISH)
+#else
+#define SPSC_FENCE()               _ReadWriteBarrier()
+#endif
+#define SPSC_INIT(index, val)      (*(index) = (val))
+#define SPSC_LOAD_RLX(index)       (*(index))
+#define SPSC_LOAD_ACQ(index)       spsc_load_acq(index)
+#define SPSC_STORE_RLX(index, val) (*(index) = (val))
+#define SPSC_STORE_REL(index, val) do { SPSC_FENCE(); *(index) = (val); } while(0)
+#else
+#define SPSC_INIT(index, val)      atomic_init(index, val)
+#define SPSC_LOAD_RLX(index)       atomic_load_explicit(index, memory_order_relaxed)
+#define SPSC_LOAD_ACQ(index)       atomic_load_explicit(index, memory_order_acquire)
+#define SPSC_STORE_RLX(index, val) atomic_store_explicit(index, val, memory_order_relaxed)
+#define SPSC_STORE_REL(index, val) atomic_store_explicit(index, val, memory_order_release)
+#endif
+
+
+/**************************************************************************************************
+*                                         LOCAL PROTOTYPES
+*************************************************^************************************************/
+#if defined(_MSC_VER)
+static uint32_t spsc_load_acq(const volatile uint32_t * const index);
+#endif
+
+
+/**************************************************************************************************
+*                                            FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Initialize ring buffer with user defined memory
+*
+*  \note Must initialize the struct before using ring buffer put and get,
+*        returns 0 for success or -1 if size is not a power of two
+******************************************************************************/
+int8_t spsc_ring_buffer_init(spsc_ring_buffer_t * const ring_buffer, uint8_t * const buffer_array, const uint32_t buffer_array_size)
+{
+	if((buffer_array_size == 0) || ((buffer_array_size & (buffer_array_size - 1)) != 0)) return -1;
+
+	ring_buffer->rb_buffer_array = buffer_array;
+	ring_buffer->rb_buffer_size  = buffer_array_size;
+	ring_buffer->rb_mask         = buffer_array_size - 1;
+	ring_buffer->rb_tail_cache   = 0;
+	ring_buffer->rb_head_cache   = 0;
+	SPSC_INIT(&ring_buffer->rb_head, 0);
+	SPSC_INIT(&ring_buffer->rb_tail, 0);
+	SPSC_INIT(&ring_buffer->rb_max_usage, 0);
+
+	return 0;
+}
+
+/******************************************************************************
+*  \brief Put data into buffer
+*
+*  \note Producer only. Returns 0 for no error and -1 for buffer full where
+*        data_to_put was dumped
+******************************************************************************/
+int8_t spsc_ring_buffer_put_data(spsc_ring_buffer_t * const ring_buffer, const uint8_t data_to_put)
+{
+	const uint32_t head = SPSC_LOAD_RLX(&ring_buffer->rb_head);
+	uint32_t usage;
+
+#if SPSC_RING_BUFFER_MAX_USAGE_EN
+	/*Need the current tail for usage anyway*/
+	ring_buffer->rb_tail_cache = SPSC_LOAD_ACQ(&ring_buffer->rb_tail);
+
+	if((head - ring_buffer->rb_tail_cache) == ring_buffer->rb_buffer_size) return -1;
+#else
+	/*Only read the consumer's index when the buffer looks full*/
+	if((head - ring_buffer->rb_tail_cache) == ring_buffer->rb_buffer_size)
+	{
+		ring_buffer->rb_tail_cache = SPSC_LOAD_ACQ(&ring_buffer->rb_tail);
+
+		if((head - ring_buffer->rb_tail_cache) == ring_buffer->rb_buffer_size) return -1;
+	}
+#endif
+
+	ring_buffer->rb_buffer_array[head & ring_buffer->rb_mask] = data_to_put;
+	SPSC_STORE_REL(&ring_buffer->rb_head, head + 1);
+
+#if SPSC_RING_BUFFER_MAX_USAGE_EN
+	/*Check peak usage*/
+	usage = head + 1 - ring_buffer->rb_tail_cache;
+	if(usage > SPSC_LOAD_RLX(&ring_buffer->rb_max_usage))
+	{
+		SPSC_STORE_RLX(&ring_buffer->rb_max_usage, usage);
+	}
+#else
+	(void)usage;
+#endif
+
+	return 0;
+}
+
+/******************************************************************************
+*  \brief Get data from buffer
+*
+*  \note Consumer only. Returns data or -1 for buffer empty
+******************************************************************************/
+int16_t spsc_ring_buffer_get_data(spsc_ring_buffer_t * const ring_buffer)
+{
+	const uint32_t tail = SPSC_LOAD_RLX(&ring_buffer->rb_tail);
+	uint8_t data;
+
+	/*Only read the producer's index when the buffer looks empty*/
+	if(tail == ring_buffer->rb_head_cache)
+	{
+		ring_buffer->rb_head_cache = SPSC_LOAD_ACQ(&ring_buffer->rb_head);
+
+		if(tail == ring_buffer->rb_head_cache) return -1;
+	}
+
+	data = ring_buffer->rb_buffer_array[tail & ring_buffer->rb_mask];
+	SPSC_STORE_REL(&ring_buffer->rb_tail, tail + 1);
+
+	return data;
+}
+
+/******************************************************************************
+*  \brief Get ring buffer max usage
+*
+*  \note returns the ring buffers current max usage, can be called from either
+*        thread. Always 0 if SPSC_RING_BUFFER_MAX_USAGE_EN is 0
+******************************************************************************/
+uint32_t spsc_ring_buffer_get_max_usage(spsc_ring_buffer_t * const ring_buffer)
+{
+	return SPSC_LOAD_RLX(&ring_buffer->rb_max_usage);
+}
+
+/******************************************************************************
+*  \brief Write data array into buffer
+*
+*  \note Producer only. Writes as much of data as fits, returns number of
+*        bytes written
+******************************************************************************/
+uint32_t spsc_ring_buffer_write(spsc_ring_buffer_t * const ring_buffer, const uint8_t * const data, const uint32_t len)
+{
+	const uint32_t head = SPSC_LOAD_RLX(&ring_buffer->rb_head);
+	const uint32_t pos  = head & ring_buffer->rb_mask;
+	uint32_t write_len;
+	uint32_t first_len;
+
+#if SPSC_RING_BUFFER_MAX_USAGE_EN
+	/*Need the current tail for usage anyway*/
+	ring_buffer->rb_tail_cache = SPSC_LOAD_ACQ(&ring_buffer->rb_tail);
+#else
+	/*Only read the consumer's index when the cached one leaves too little room*/
+	if((ring_buffer->rb_buffer_size - (head - ring_buffer->rb_tail_cache)) < len)
+	{
+		ring_buffer->rb_tail_cache = SPSC_LOAD_ACQ(&ring_buffer->rb_tail);
+	}
+#endif
+
+	write_len = ring_buffer->rb_buffer_size - (head - ring_buffer->rb_tail_cache);
+	if(write_len > len) write_len = len;
+
+	/*Copy up to the end of the array then the rest from the start*/
+	first_len = ring_buffer->rb_buffer_size - pos;
+	if(first_len > write_len) first_len = write_len;
+
+	memcpy(&ring_buffer->rb_buffer_array[pos], data, first_len);
+	memcpy(ring_buffer->rb_buffer_array, data + first_len, write_len - first_len);
+
+	SPSC_STORE_REL(&ring_buffer->rb_head, head + write_len);
+
+#if SPSC_RING_BUFFER_MAX_USAGE_EN
+	/*Check peak usage*/
+	if((head + write_len - ring_buffer->rb_tail_cache) > SPSC_LOAD_RLX(&ring_buffer->rb_max_usage))
+	{
+		SPSC_STORE_RLX(&ring_buffer->rb_max_usage, head + write_len - ring_buffer->rb_tail_cache);
+	}
+#endif
+
+	return write_len;
+}
+
+/******************************************************************************
+*  \brief Read data array from buffer
+*
+*  \note Consumer only. Reads up to len bytes, returns number of bytes read
+******************************************************************************/
+uint32_t spsc_ring_buffer_read(spsc_ring_buffer_t * const ring_buffer, uint8_t * const data, const uint32_t len)
+{
+	const uint32_t tail = SPSC_LOAD_RLX(&ring_buffer->rb_tail);
+	const uint32_t pos  = tail & ring_buffer->rb_mask;
+	uint32_t read_len;
+	uint32_t first_len;
+
+	ring_buffer->rb_head_cache = SPSC_LOAD_ACQ(&ring_buffer->rb_head);
+
+	read_len = ring_buffer->rb_head_cache - tail;
+	if(read_len > len) read_len = len;
+
+	/*Copy up to the end of the array then the rest from the start*/
+	first_len = ring_buffer->rb_buffer_size - pos;
+	if(first_len > read_len) first_len = read_len;
+
+	memcpy(data, &ring_buffer->rb_buffer_array[pos], first_len);
+	memcpy(data + first_len, ring_buffer->rb_buffer_array, read_len - first_len);
+
+	SPSC_STORE_REL(&ring_buffer->rb_tail, tail + read_len);
+
+	return read_len;
+}
+
+
+/**************************************************************************************************
+*                                         LOCAL FUNCTIONS
+*************************************************^************************************************/
+#if defined(_MSC_VER)
+/******************************************************************************
+*  \brief Load acquire
+*
+*  \note reads index before any access after it
+******************************************************************************/
+static uint32_t spsc_load_acq(const volatile uint32_t * const index)
+{
+	const uint32_t val = *index;
+
+	SPSC_FENCE();
+
+	return val;
+}
+#endif
@@ -0,0 +1,67 @@
+/*
+ * spsc_ring_buffer.h
+ *
+ * Created: 10/16/2026
+ */
+
+
+#ifndef SPSC_RING_BUFFER_H_
+#define SPSC_RING_BUFFER_H_
+
+
+#include <stdint.h>
+
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#ifndef SPSC_RING_BUFFER_CACHE_LINE_BYTES
+#define SPSC_RING_BUFFER_CACHE_LINE_BYTES 64
+#endif
+
+/*Index qualifiers, MSVC has no C11 atomics in the v141/v142 toolsets so its indexes are volatile, see spsc_ring_buffer.c*/
+#if defined(_MSC_VER)
+#define SPSC_RING_BUFFER_ATOMIC volatile
+#define SPSC_RING_BUFFER_ALIGN  __declspec(align(SPSC_RING_BUFFER_CACHE_LINE_BYTES))
+#else
+#include <stdatomic.h>
+#define SPSC_RING_BUFFER_ATOMIC _Atomic
+#define SPSC_RING_BUFFER_ALIGN  _Alignas(SPSC_RING_BUFFER_CACHE_LINE_BYTES)
+#endif
+
+/*Set to 1 for max usage tracking, put and write then read the consumer index on every call instead of only when the buffer looks full*/
+#ifndef SPSC_RING_BUFFER_MAX_USAGE_EN
+#define SPSC_RING_BUFFER_MAX_USAGE_EN 0
+#endif
+
+typedef struct spsc_ring_buffer_t
+{
+	/*Producer*/
+	SPSC_RING_BUFFER_ALIGN SPSC_RING_BUFFER_ATOMIC uint32_t rb_head;
+	uint32_t rb_tail_cache;                                   //last rb_tail seen by producer
+	SPSC_RING_BUFFER_ATOMIC uint32_t rb_max_usage;
+
+	/*Consumer*/
+	SPSC_RING_BUFFER_ALIGN SPSC_RING_BUFFER_ATOMIC uint32_t rb_tail;
+	uint32_t rb_head_cache;                                   //last rb_head seen by consumer
+
+	/*Read only after init*/
+	SPSC_RING_BUFFER_ALIGN uint8_t *rb_buffer_array;
+	uint32_t rb_buffer_size;
+	uint32_t rb_mask;
+} spsc_ring_buffer_t;
+
+
+/**************************************************************************************************
+*                                            PROTOTYPES
+*************************************************^************************************************/
+int8_t   spsc_ring_buffer_init         (spsc_ring_buffer_t * const ring_buffer, uint8_t * const buffer_array, const uint32_t buffer_array_size);
+int8_t   spsc_ring_buffer_put_data     (spsc_ring_buffer_t * const ring_buffer, const uint8_t data_to_put);
+int16_t  spsc_ring_buffer_get_data     (spsc_ring_buffer_t * const ring_buffer);
+uint32_t spsc_ring_buffer_get_max_usage(spsc_ring_buffer_t * const ring_buffer);
+
+uint32_t spsc_ring_buffer_write        (spsc_ring_buffer_t * const ring_buffer, const uint8_t * const data, const uint32_t len);
+uint32_t spsc_ring_buffer_read         (spsc_ring_buffer_t * const ring_buffer, uint8_t * const data, const uint32_t len);
+
+
+#endif /* SPSC_RING_BUFFER_H_ */
@@ -0,0 +1,347 @@
+/*
+ * pckt_sim.c
+ *
+ * Created: 10/16/2026
+ */
+
+
+#include <string.h>
+
+#include "pckt_sim.h"
+
+/**************************************************************************************************
+*                                         LOCAL PROTOTYPES
+*************************************************^************************************************/
+static uint32_t sim_rand   (pckt_sim_chan_t * const chan);
+static uint8_t  sim_chance (pckt_sim_chan_t * const chan, const uint32_t ppm);
+static uint8_t  sim_corrupt(pckt_sim_chan_t * const chan, uint8_t data);
+static void     sim_enqueue(pckt_sim_chan_t * const chan, const uint64_t arrival, const uint8_t data);
+
+
+/**************************************************************************************************
+*                                            FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Get config defaults
+*
+*  \note perfect link, no bandwidth limit, latency or errors
+******************************************************************************/
+void pckt_sim_get_config_defaults(pckt_sim_conf_t * const sim_conf)
+{
+	memset(sim_conf, 0, sizeof(*sim_conf));
+
+	sim_conf->seed = 1;
+}
+
+/******************************************************************************
+*  \brief Link init
+*
+*  \note starts the clock at 0, both directions still need pckt_sim_chan_init()
+******************************************************************************/
+void pckt_sim_init(pckt_sim_t * const sim)
+{
+	memset(sim->chan, 0, sizeof(sim->chan));
+
+	sim->tick = 0;
+	sim->now  = 0;
+}
+
+/******************************************************************************
+*  \brief Direction init
+*
+*  \note queue holds the bytes in flight, size is the most that can be on the
+*        wire plus waiting to be read
+******************************************************************************/
+void pckt_sim_chan_init(pckt_sim_t * const sim, const pckt_sim_dir_t dir, const pckt_sim_conf_t sim_conf, pckt_sim_byte_t * const queue, const uint32_t size)
+{
+	pckt_sim_chan_t * const chan = &sim->chan[dir];
+
+	memset(chan, 0, sizeof(*chan));
+
+	chan->conf  = sim_conf;
+	chan->queue = queue;
+	chan->size  = size;
+	chan->rand  = (sim_conf.seed != 0) ? sim_conf.seed : 1;
+}
+
+/******************************************************************************
+*  \brief Advance clock
+*
+*  \note
+******************************************************************************/
+void pckt_sim_advance(pckt_sim_t * const sim, const TICK_TYPE ticks)
+{
+	sim->now  += ticks;
+	sim->tick += ticks;
+}
+
+/******************************************************************************
+*  \brief Write
+*
+*  \note puts data on the wire, call from tx_data_fprt of the sending end
+******************************************************************************/
+void pckt_sim_write(pckt_sim_t * const sim, const pckt_sim_dir_t dir, const uint8_t * const data, const uint32_t len)
+{
+	pckt_sim_chan_t * const chan = &sim->chan[dir];
+	uint64_t start;
+	uint64_t arrival;
+	TICK_TYPE delay = 0;
+	uint8_t lost;
+	uint32_t i;
+
+	if(sim_chance(chan, chan->conf.reorder_ppm))
+	{
+		delay = chan->conf.reorder_delay;
+		chan->stats.reordered++;
+	}
+
+	lost = sim_chance(chan, chan->conf.loss_ppm);
+
+	if(lost) chan->stats.lost++;
+
+	chan->stats.tx_bytes += len;
+
+	for(i = 0; i < len; i++)
+	{
+		/*Wire time, in 1/1000 tick*/
+		start = sim->now * 1000;
+
+		if(chan->wire_free > start) start = chan->wire_free;
+
+		chan->wire_free = start + ((chan->conf.rate != 0) ? (1000000 / chan->conf.rate) : 0);
+		arrival = ((chan->wire_free + 999) / 1000) + chan->conf.latency + delay;
+
+		if(lost) continue;
+
+		if(sim_chance(chan, chan->conf.drop_ppm))
+		{
+			chan->stats.dropped++;
+			continue;
+		}
+
+		sim_enqueue(chan, arrival, sim_corrupt(chan, data[i]));
+	}
+}
+
+/******************************************************************************
+*  \brief Read
+*
+*  \note returns up to len bytes that have arrived, for rx_block_fptr of the
+*        receiving end
+******************************************************************************/
+uint16_t pckt_sim_read(pckt_sim_t * const sim, const pckt_sim_dir_t dir, uint8_t * const data, const uint16_t len)
+{
+	pckt_sim_chan_t * const chan = &sim->chan[dir];
+	uint16_t num = 0;
+
+	while((num < len) && (chan->count > 0) && (chan->queue[chan->head].arrival <= sim->now))
+	{
+		data[num++] = chan->queue[chan->head].data;
+
+		chan->head = (chan->head + 1) % chan->size;
+		chan->count--;
+	}
+
+	chan->stats.rx_bytes += num;
+
+	return num;
+}
+
+/******************************************************************************
+*  \brief Read byte
+*
+*  \note returns a byte that has arrived or -1, for rx_byte_fptr
+******************************************************************************/
+int16_t pckt_sim_read_byte(pckt_sim_t * const sim, const pckt_sim_dir_t dir)
+{
+	uint8_t data;
+
+	if(pckt_sim_read(sim, dir, &data, 1) == 0) return -1;
+
+	return data;
+}
+
+/******************************************************************************
+*  \brief Available
+*
+*  \note returns the number of bytes that have arrived and can be read
+******************************************************************************/
+uint32_t pckt_sim_avail(const pckt_sim_t * const sim, const pckt_sim_dir_t dir)
+{
+	const pckt_sim_chan_t * const chan = &sim->chan[dir];
+	uint32_t num = 0;
+
+	while((num < chan->count) && (chan->queue[(chan->head + num) % chan->size].arrival <= sim->now))
+	{
+		num++;
+	}
+
+	return num;
+}
+
+/******************************************************************************
+*  \brief In flight
+*
+*  \note returns the number of bytes on the wire or waiting to be read, 0
+*        once the direction is idle
+******************************************************************************/
+uint32_t pckt_sim_in_flight(const pckt_sim_t * const sim, const pckt_sim_dir_t dir)
+{
+	return sim->chan[dir].count;
+}
+
+/******************************************************************************
+*  \brief Latency reset
+*
+*  \note
+******************************************************************************/
+void pckt_sim_lat_reset(pckt_sim_lat_t * const lat)
+{
+	memset(lat, 0, sizeof(*lat));
+}
+
+/******************************************************************************
+*  \brief Latency add
+*
+*  \note
+******************************************************************************/
+void pckt_sim_lat_add(pckt_sim_lat_t * const lat, const TICK_TYPE ticks)
+{
+	lat->count++;
+	lat->total += ticks;
+	lat->hist[(ticks < PCKT_SIM_LAT_BUCKETS) ? ticks : (PCKT_SIM_LAT_BUCKETS - 1)]++;
+
+	if(ticks > lat->max) lat->max = ticks;
+}
+
+/******************************************************************************
+*  \brief Latency percentile
+*
+*  \note returns the latency pct percent of the samples are at or under, max
+*        for 100 or one in the last bucket and 0 without samples
+******************************************************************************/
+TICK_TYPE pckt_sim_lat_pct(const pckt_sim_lat_t * const lat, const uint8_t pct)
+{
+	uint64_t want;
+	uint64_t sum = 0;
+	uint32_t i;
+
+	if(lat->count == 0) return 0;
+	if(pct >= 100) return lat->max;
+
+	want = (((uint64_t)lat->count * pct) + 99) / 100;
+
+	if(want == 0) want = 1;
+
+	for(i = 0; i < (PCKT_SIM_LAT_BUCKETS - 1); i++)
+	{
+		sum += lat->hist[i];
+
+		if(sum >= want) return (TICK_TYPE)i;
+	}
+
+	return lat->max;
+}
+
+
+/**************************************************************************************************
+*                                         LOCAL FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Random
+*
+*  \note xorshift32, the same sequence on every host
+******************************************************************************/
+static uint32_t sim_rand(pckt_sim_chan_t * const chan)
+{
+	uint32_t x = chan->rand;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	chan->rand = x;
+
+	return x;
+}
+
+/******************************************************************************
+*  \brief Chance
+*
+*  \note returns 1 with a probability of ppm parts per million, uses no random
+*        number for 0 so adding one error type does not change the others
+******************************************************************************/
+static uint8_t sim_chance(pckt_sim_chan_t * const chan, const uint32_t ppm)
+{
+	if(ppm == 0) return 0;
+
+	return (sim_rand(chan) % 1000000) < ppm;
+}
+
+/******************************************************************************
+*  \brief Corrupt
+*
+*  \note applies burst and bit errors to one byte
+******************************************************************************/
+static uint8_t sim_corrupt(pckt_sim_chan_t * const chan, uint8_t data)
+{
+	const uint8_t orig = data;
+	uint8_t bit;
+
+	if((chan->burst_left == 0) && (chan->conf.burst_len > 0) && sim_chance(chan, chan->conf.burst_ppm))
+	{
+		chan->burst_left = chan->conf.burst_len;
+		chan->stats.bursts++;
+	}
+
+	if(chan->burst_left > 0)
+	{
+		chan->burst_left--;
+		data ^= (uint8_t)(sim_rand(chan) | 1);
+	}
+
+	if(chan->conf.bit_err_ppm != 0)
+	{
+		for(bit = 0; bit < 8; bit++)
+		{
+			if(sim_chance(chan, chan->conf.bit_err_ppm)) data ^= (uint8_t)(1 << bit);
+		}
+	}
+
+	if(data != orig) chan->stats.corrupted++;
+
+	return data;
+}
+
+/******************************************************************************
+*  \brief Enqueue
+*
+*  \note keeps the queue sorted by arrival, a byte goes after any that arrive
+*        at the same time
+******************************************************************************/
+static void sim_enqueue(pckt_sim_chan_t * const chan, const uint64_t arrival, const uint8_t data)
+{
+	uint32_t pos = chan->count;
+	uint32_t prev;
+
+	if(chan->count >= chan->size)
+	{
+		chan->stats.overflow++;
+		return;
+	}
+
+	/*Held back bytes are the only ones a new byte can overtake*/
+	while(pos > 0)
+	{
+		prev = (chan->head + pos - 1) % chan->size;
+
+		if(chan->queue[prev].arrival <= arrival) break;
+
+		chan->queue[(chan->head + pos) % chan->size] = chan->queue[prev];
+		pos--;
+	}
+
+	chan->queue[(chan->head + pos) % chan->size].arrival = arrival;
+	chan->queue[(chan->head + pos) % chan->size].data    = data;
+	chan->count++;
+}
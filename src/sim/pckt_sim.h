@@ -0,0 +1,157 @@
+/*
+ * pckt_sim.h
+ *
+ * Created: 10/16/2026
+ */
+
+/*
+ * Simulated link between two instances, driven by a virtual clock so every run with the same seed
+ * gives the same result. Each direction has its own bandwidth, latency, bit errors, burst errors,
+ * byte drops and reordering, for comparing parser and protocol settings without hardware.
+ *
+ * HOW TO USE
+ * 1.DECLARE LINK, ONE QUEUE PER DIRECTION FOR THE BYTES IN FLIGHT
+ * static pckt_sim_byte_t ab_queue[4096];
+ * static pckt_sim_byte_t ba_queue[4096];
+ * static pckt_sim_t sim;
+ *
+ * 2.INITIALIZE
+ * pckt_sim_get_config_defaults(&sim_conf);
+ * sim_conf.rate        = 11520;        //115200 baud with ms ticks
+ * sim_conf.latency     = 5;
+ * sim_conf.bit_err_ppm = 10;
+ * pckt_sim_init(&sim);
+ * pckt_sim_chan_init(&sim, PCKT_SIM_A_TO_B, sim_conf, ab_queue, 4096);
+ * pckt_sim_chan_init(&sim, PCKT_SIM_B_TO_A, sim_conf, ba_queue, 4096);
+ *
+ * 3.CONNECT INSTANCES, tick_ptr, tx_data_fprt AND rx_block_fptr OF EACH END
+ * pckt_conf.tick_ptr = &sim.tick;
+ * void a_tx(const uint8_t * const data, uint8_t len) { pckt_sim_write(&sim, PCKT_SIM_A_TO_B, data, len); }
+ * uint16_t a_rx(uint8_t * const data, const uint16_t len) { return pckt_sim_read(&sim, PCKT_SIM_B_TO_A, data, len); }
+ * ...b_tx and b_rx the other way round
+ *
+ * 4.RUN
+ * pckt_task(&a_inst, a_handler);
+ * pckt_task(&b_inst, b_handler);
+ * pckt_sim_advance(&sim, 1);
+ *
+ * 5.MEASURE, e.g. put sim.tick in the payload and add its age on arrival
+ * pckt_sim_lat_add(&lat, sim.tick - sent_tick);
+ * pckt_sim_lat_pct(&lat, 99);          //99th percentile in ticks
+ *
+ * TIMING, a byte is on the wire for 1000 / rate ticks after the previous one, and arrives latency
+ * ticks after its last bit. Dropped bytes and lost writes still take their wire time.
+ */
+
+
+#ifndef PCKT_SIM_H_
+#define PCKT_SIM_H_
+
+
+#include <stdint.h>
+
+#include "../timer.h"
+
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#ifndef PCKT_SIM_LAT_BUCKETS
+#define PCKT_SIM_LAT_BUCKETS 4096 //latency histogram buckets of one tick, the last one also takes anything longer
+#endif
+
+/*Link direction*/
+typedef enum pckt_sim_dir_t
+{
+	PCKT_SIM_A_TO_B,
+	PCKT_SIM_B_TO_A,
+	PCKT_SIM_DIRS
+} pckt_sim_dir_t;
+
+/*Direction configuration, see pckt_sim_get_config_defaults()*/
+typedef struct pckt_sim_conf_t
+{
+	uint32_t rate;                       //bytes per 1000 ticks (bytes/s with ms ticks), 0 for no limit
+	TICK_TYPE latency;                   //ticks from the last bit of a byte to its arrival
+	uint32_t bit_err_ppm;                //chance per bit of being flipped, parts per million
+	uint32_t burst_ppm;                  //chance per byte of a burst error starting
+	uint16_t burst_len;                  //bytes garbled by one burst
+	uint32_t drop_ppm;                   //chance per byte of being lost
+	uint32_t loss_ppm;                   //chance per pckt_sim_write() of all its bytes being lost, a whole packet when tx_data_fprt gets one per call
+	uint32_t reorder_ppm;                //chance per pckt_sim_write() of being held back so later writes overtake it
+	TICK_TYPE reorder_delay;             //extra latency of a held back write
+	uint32_t seed;                       //random seed, runs with the same seed are the same
+} pckt_sim_conf_t;
+
+/*Byte in flight*/
+typedef struct pckt_sim_byte_t
+{
+	uint64_t arrival;                    //pckt_sim_t now the byte can be read
+	uint8_t data;
+} pckt_sim_byte_t;
+
+/*Direction statistics*/
+typedef struct pckt_sim_stats_t
+{
+	uint32_t tx_bytes;                   //bytes written
+	uint32_t rx_bytes;                   //bytes read
+	uint32_t dropped;                    //bytes lost, drop_ppm
+	uint32_t lost;                       //writes lost, loss_ppm
+	uint32_t corrupted;                  //bytes changed by bit or burst errors
+	uint32_t bursts;                     //burst errors started
+	uint32_t reordered;                  //writes held back
+	uint32_t overflow;                   //bytes lost because the queue was full
+} pckt_sim_stats_t;
+
+/*One direction*/
+typedef struct pckt_sim_chan_t
+{
+	pckt_sim_conf_t conf;
+	pckt_sim_byte_t *queue;              //bytes in flight, sorted by arrival
+	uint32_t size;
+	uint32_t head;
+	uint32_t count;
+	uint64_t wire_free;                  //1/1000 tick the wire is free for the next byte
+	uint32_t rand;                       //random state
+	uint16_t burst_left;                 //bytes left of the burst being sent
+	pckt_sim_stats_t stats;
+} pckt_sim_chan_t;
+
+/*Link struct*/
+typedef struct pckt_sim_t
+{
+	volatile TICK_TYPE tick;             //virtual clock, for tick_ptr of the instances
+	uint64_t now;                        //ticks since pckt_sim_init(), does not wrap
+	pckt_sim_chan_t chan[PCKT_SIM_DIRS];
+} pckt_sim_t;
+
+/*Latency distribution*/
+typedef struct pckt_sim_lat_t
+{
+	uint32_t count;
+	uint64_t total;
+	TICK_TYPE max;
+	uint32_t hist[PCKT_SIM_LAT_BUCKETS]; //hist[n] counts latencies of n ticks
+} pckt_sim_lat_t;
+
+
+/**************************************************************************************************
+*                                            PROTOTYPES
+*************************************************^************************************************/
+void      pckt_sim_get_config_defaults(pckt_sim_conf_t * const sim_conf);
+void      pckt_sim_init       (pckt_sim_t * const sim);
+void      pckt_sim_chan_init  (pckt_sim_t * const sim, const pckt_sim_dir_t dir, const pckt_sim_conf_t sim_conf, pckt_sim_byte_t * const queue, const uint32_t size);
+void      pckt_sim_advance    (pckt_sim_t * const sim, const TICK_TYPE ticks);
+
+void      pckt_sim_write      (pckt_sim_t * const sim, const pckt_sim_dir_t dir, const uint8_t * const data, const uint32_t len);
+uint16_t  pckt_sim_read       (pckt_sim_t * const sim, const pckt_sim_dir_t dir, uint8_t * const data, const uint16_t len);
+int16_t   pckt_sim_read_byte  (pckt_sim_t * const sim, const pckt_sim_dir_t dir);
+uint32_t  pckt_sim_avail      (const pckt_sim_t * const sim, const pckt_sim_dir_t dir);
+uint32_t  pckt_sim_in_flight  (const pckt_sim_t * const sim, const pckt_sim_dir_t dir);
+
+void      pckt_sim_lat_reset  (pckt_sim_lat_t * const lat);
+void      pckt_sim_lat_add    (pckt_sim_lat_t * const lat, const TICK_TYPE ticks);
+TICK_TYPE pckt_sim_lat_pct    (const pckt_sim_lat_t * const lat, const uint8_t pct);
+
+
+#endif /* PCKT_SIM_H_ */
@@ -0,0 +1,567 @@
+/*
+ * sim.c
+ *
+ * Created: 10/16/2026
+ */
+
+/*
+ * Link simulator runs, compares parser and protocol modes over the same simulated links. Built by
+ * the Sim target of packet.cbp, or by hand
+ *
+ * gcc -O2 -DPCKT_TICK_GLOBAL_EN=0 -DPCKT_STATS_EN=1 -Isrc src/sim/sim.c src/sim/pckt_sim.c src/packet.c src/pckt_rel.c -o packet_sim
+ *
+ * A sends SIM_PAYLOAD_LEN byte frames to B every SIM_INTERVAL ticks for SIM_RUN ticks, then the
+ * link drains for SIM_DRAIN ticks. Ticks are ms, the link is 115200 baud with 5 ms latency. Each
+ * payload carries its sequence number and the tick it was made, B counts every sequence number
+ * once and records its age. Reported per mode and link:
+ *
+ * loss     frames never delivered
+ * goodput  payload bytes delivered per second of SIM_RUN
+ * latency  p50, p90, p99 and max ms from making a frame to its delivery, with reliable delivery
+ *          this includes waiting for a free window slot
+ *
+ * First the parser is checked on cases that once lost packets, the run stops with exit code 1 if
+ * one fails.
+ *
+ * Then reliable delivery is swept over windows and packet loss on a slow, long link of 10 bytes
+ * per ms and 100 ms one way. A sends SIM_SWEEP_PACKETS as fast as the window lets it, reported
+ * is packets per second until B has them all and the retransmissions needed.
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../packet.h"
+#include "../pckt_rel.h"
+#include "../pckt_sr.h"
+#include "pckt_sim.h"
+
+/**************************************************************************************************
+*                                             DEFINES
+*************************************************^************************************************/
+#define SIM_PAYLOAD_LEN  32      //bytes per frame, [SEQ:3 ... SEQ:0][TICK:3 ... TICK:0][FILL ...]
+#define SIM_INTERVAL     4       //ticks between frames, about 80% of the link
+#define SIM_RUN          20000   //ticks frames are made
+#define SIM_DRAIN        3000    //ticks after SIM_RUN for frames in flight
+#define SIM_FRAMES       (SIM_RUN / SIM_INTERVAL)
+#define SIM_QUEUE_LEN    8192    //bytes in flight per direction
+#define SIM_DATA_ID      0x0100
+#define SIM_RX_BUF_LEN   (SIM_PAYLOAD_LEN + PCKT_REL_HDR_LEN + 5)
+#define SIM_RX_TIMEOUT   10      //clear_buffer_timeout
+#define SIM_REL_WINDOW   8
+#define SIM_REL_TIMEOUT  60
+
+#define SIM_SWEEP_PACKETS 2000   //packets per window and loss run
+#define SIM_SWEEP_LEN     8      //payload bytes, [SEQ:3 ... SEQ:0][TICK:3 ... TICK:0]
+#define SIM_SWEEP_RATE    10000  //10 bytes per ms
+#define SIM_SWEEP_LATENCY 100
+#define SIM_SWEEP_TIMEOUT 300
+#define SIM_SWEEP_MAX     10000000 //ticks before a run is given up
+
+#define SIM_CHECK_ID      0x0120 //ID:0 read as the LEN of a header starting one byte early is more than follows
+#define SIM_CHECK_BUSY_ID 0x0099 //ID that only gets busy after the stats entries are full
+#define SIM_CHECK_BUSY    5000   //SIM_CHECK_BUSY_ID packets, each followed by an ID seen once
+
+/*Parser and protocol mode*/
+typedef enum sim_mode_t
+{
+	SIM_MODE_DROP,                       //drop the buffer on crc error
+	SIM_MODE_RESYNC,                     //slide to the next valid packet on crc error
+	SIM_MODE_REL,                        //resync and reliable delivery
+	SIM_MODES
+} sim_mode_t;
+
+/*Link*/
+typedef struct sim_link_t
+{
+	const char *name;
+	uint32_t bit_err_ppm;
+	uint32_t burst_ppm;
+	uint16_t burst_len;
+	uint32_t drop_ppm;
+	uint32_t reorder_ppm;
+	TICK_TYPE reorder_delay;
+} sim_link_t;
+
+
+/**************************************************************************************************
+*                                         LOCAL PROTOTYPES
+*************************************************^************************************************/
+static uint8_t  sim_check_stray(void);
+static uint8_t  sim_check_stats(void);
+static void     sim_check_tx   (const uint16_t id);
+static void     sim_run        (const sim_mode_t mode, const sim_link_t * const link);
+static void     sim_sweep      (const uint8_t window, const uint32_t loss_ppm);
+static void     sim_setup      (pckt_sim_conf_t sim_conf, const pckt_en_t resync, const uint8_t window, const TICK_TYPE timeout);
+static void     sim_step       (const uint8_t window);
+static void     sim_deliver    (const uint8_t * const payload, const uint16_t len);
+
+static void     a_tx_data      (const uint8_t * const data, uint8_t len);
+static uint16_t a_rx_block     (uint8_t * const data, const uint16_t len);
+static void     b_tx_data      (const uint8_t * const data, uint8_t len);
+static uint16_t b_rx_block     (uint8_t * const data, const uint16_t len);
+
+static void     a_handler      (pckt_inst_t * const pckt_inst, const pckt_view_t * const pckt_view);
+static void     b_handler      (pckt_inst_t * const pckt_inst, const pckt_view_t * const pckt_view);
+static void     check_handler  (pckt_inst_t * const pckt_inst, const pckt_view_t * const pckt_view);
+
+
+/**************************************************************************************************
+*                                            VARIABLES
+*************************************************^************************************************/
+static pckt_sim_t sim;
+
+static pckt_sim_byte_t ab_queue[SIM_QUEUE_LEN];
+static pckt_sim_byte_t ba_queue[SIM_QUEUE_LEN];
+
+static pckt_inst_t a_pckt_inst;
+static pckt_inst_t b_pckt_inst;
+static uint8_t a_rx_buffer[SIM_RX_BUF_LEN];
+static uint8_t b_rx_buffer[SIM_RX_BUF_LEN];
+
+static uint8_t a_rel_pool[2 * PCKT_REL_WINDOW_MAX * SIM_PAYLOAD_LEN];
+static uint8_t b_rel_pool[2 * PCKT_REL_WINDOW_MAX * SIM_PAYLOAD_LEN];
+static pckt_rel_slot_t a_rel_slots[2 * PCKT_REL_WINDOW_MAX];
+static pckt_rel_slot_t b_rel_slots[2 * PCKT_REL_WINDOW_MAX];
+static pckt_rel_t a_rel;
+static pckt_rel_t b_rel;
+
+static uint8_t seen[SIM_FRAMES];         //frame delivered
+static uint32_t delivered;               //frames delivered at least once
+static pckt_sim_lat_t lat;
+static uint32_t check_rx;                //SIM_CHECK_ID packets received
+
+static const char * const mode_name[SIM_MODES] =
+{
+	"drop",
+	"resync",
+	"rel w8"
+};
+
+static const uint8_t sweep_windows[] = {1, 8, 32};
+static const uint32_t sweep_loss_ppm[] = {0, 10000, 50000, 200000};
+
+static const sim_link_t links[] =
+{
+	/*name           bit ppm  burst ppm  len  drop ppm  reorder ppm  delay*/
+	{"clean",        0,       0,         0,   0,        0,           0},
+	{"ber 1e-5",     10,      0,         0,   0,        0,           0},
+	{"ber 1e-4",     100,     0,         0,   0,        0,           0},
+	{"burst",        0,       200,       16,  0,        0,           0},
+	{"drop 1e-3",    0,       0,         0,   1000,     0,           0},
+	{"reorder 1%",   0,       0,         0,   0,        10000,       20},
+};
+
+
+/**************************************************************************************************
+*                                            FUNCTIONS
+*************************************************^************************************************/
+int main(void)
+{
+	char col[16];
+	uint8_t mode;
+	uint8_t i;
+	uint8_t j;
+
+	if((sim_check_stray() | sim_check_stats()) != 0)
+	{
+		fprintf(stderr, "SIM CHECK FAILED\n");
+		return 1;
+	}
+
+	printf("\n%-8s %-12s %7s %9s %7s %9s %6s %6s %6s %6s\n", "mode", "link", "frames", "delivered", "loss %", "goodput", "p50", "p90", "p99", "max");
+
+	for(i = 0; i < (sizeof(links) / sizeof(links[0])); i++)
+	{
+		for(mode = 0; mode < SIM_MODES; mode++)
+		{
+			sim_run((sim_mode_t)mode, &links[i]);
+		}
+	}
+
+	printf("\nreliable delivery, %u B/ms, %u ms one way, %u packets, packets/s (retransmissions)\n", SIM_SWEEP_RATE / 1000, SIM_SWEEP_LATENCY, SIM_SWEEP_PACKETS);
+	printf("%-6s", "window");
+
+	for(j = 0; j < (sizeof(sweep_loss_ppm) / sizeof(sweep_loss_ppm[0])); j++)
+	{
+		snprintf(col, sizeof(col), "loss %u%%", (unsigned)(sweep_loss_ppm[j] / 10000));
+		printf("   %-15s", col);
+	}
+
+	printf("\n");
+
+	for(i = 0; i < sizeof(sweep_windows); i++)
+	{
+		printf("%6u", sweep_windows[i]);
+
+		for(j = 0; j < (sizeof(sweep_loss_ppm) / sizeof(sweep_loss_ppm[0])); j++)
+		{
+			sim_sweep(sweep_windows[i], sweep_loss_ppm[j]);
+		}
+
+		printf("\n");
+	}
+
+	return 0;
+}
+
+
+/**************************************************************************************************
+*                                         LOCAL FUNCTIONS
+*************************************************^************************************************/
+/******************************************************************************
+*  \brief Check stray byte
+*
+*  \note a stray byte, two packets, then a quiet line. The header the stray
+*        byte starts has a LEN that never arrives, with resync the timeout
+*        must still find both packets behind it. Returns 1 on failure
+******************************************************************************/
+static uint8_t sim_check_stray(void)
+{
+	pckt_sim_conf_t sim_conf;
+	const uint8_t stray = 0xAA;
+	const uint8_t payload[4] = {0x11, 0x22, 0x33, 0x44};
+	uint8_t fail;
+	TICK_TYPE t;
+
+	pckt_sim_get_config_defaults(&sim_conf);
+	sim_setup(sim_conf, PCKT_ENABLED, 0, 0);
+	check_rx = 0;
+
+	pckt_sim_write(&sim, PCKT_SIM_A_TO_B, &stray, 1);
+	pckt_tx_raw(&a_pckt_inst, SIM_CHECK_ID, payload, sizeof(payload));
+	pckt_tx_raw(&a_pckt_inst, SIM_CHECK_ID, payload, sizeof(payload));
+
+	for(t = 0; t < (2 * SIM_RX_TIMEOUT); t++)
+	{
+		pckt_task_view(&b_pckt_inst, check_handler);
+		pckt_sim_advance(&sim, 1);
+	}
+
+	fail = (check_rx != 2);
+#if PCKT_STATS_EN
+	fail |= (b_pckt_inst.stats.rx_timeout != 1);
+#endif
+
+	printf("check stray byte, 2 packets, quiet line: %u delivered %s\n", (unsigned)check_rx, fail ? "FAIL" : "ok");
+
+	return fail;
+}
+
+/******************************************************************************
+*  \brief Check stats IDs
+*
+*  \note PCKT_STATS_IDS IDs with 100 packets each, then an ID that gets busy
+*        between IDs seen once. The busy one must get a stats entry, with a
+*        count from its packets to its packets plus rx_frames_over. Returns 1
+*        on failure
+******************************************************************************/
+static uint8_t sim_check_stats(void)
+{
+#if PCKT_STATS_EN
+	const pckt_stats_id_t *entry = 0;
+	pckt_sim_conf_t sim_conf;
+	uint8_t fail;
+	uint16_t i;
+	uint8_t j;
+
+	pckt_sim_get_config_defaults(&sim_conf);
+	sim_setup(sim_conf, PCKT_ENABLED, 0, 0);
+
+	for(i = 0; i < 100; i++)
+	{
+		for(j = 0; j < PCKT_STATS_IDS; j++)
+		{
+			sim_check_tx(0x0010 + j);
+		}
+	}
+
+	for(i = 0; i < SIM_CHECK_BUSY; i++)
+	{
+		sim_check_tx(SIM_CHECK_BUSY_ID);
+		sim_check_tx(0x1000 + i);
+	}
+
+	for(j = 0; j < PCKT_STATS_IDS; j++)
+	{
+		if((b_pckt_inst.stats.ids[j].id == SIM_CHECK_BUSY_ID) && (b_pckt_inst.stats.ids[j].rx_frames > 0)) entry = &b_pckt_inst.stats.ids[j];
+	}
+
+	fail = (entry == 0) || (entry->rx_frames < SIM_CHECK_BUSY) || ((entry->rx_frames - entry->rx_frames_over) > SIM_CHECK_BUSY);
+
+	printf("check stats ID busy after %u IDs: %u packets, %u counted (%u over) %s\n", PCKT_STATS_IDS, SIM_CHECK_BUSY,
+		   (entry != 0) ? (unsigned)entry->rx_frames : 0, (entry != 0) ? (unsigned)entry->rx_frames_over : 0, fail ? "FAIL" : "ok");
+
+	return fail;
+#else
+	return 0;
+#endif
+}
+
+/******************************************************************************
+*  \brief Check send
+*
+*  \note one empty packet from A, parsed by B once it arrives
+******************************************************************************/
+static void sim_check_tx(const uint16_t id)
+{
+	pckt_tx_raw(&a_pckt_inst, id, 0, 0);
+
+	while(pckt_sim_avail(&sim, PCKT_SIM_A_TO_B) > 0)
+	{
+		pckt_task_view(&b_pckt_inst, check_handler);
+	}
+}
+
+/******************************************************************************
+*  \brief Run one mode over one link
+*
+*  \note
+******************************************************************************/
+static void sim_run(const sim_mode_t mode, const sim_link_t * const link)
+{
+	pckt_sim_conf_t sim_conf;
+	uint8_t payload[SIM_PAYLOAD_LEN];
+	uint32_t next_seq = 0;
+	uint32_t t;
+	uint16_t i;
+
+	memset(seen, 0, sizeof(seen));
+	delivered = 0;
+	pckt_sim_lat_reset(&lat);
+
+	for(i = 0; i < sizeof(payload); i++)
+	{
+		payload[i] = (uint8_t)(i * 37);
+	}
+
+	/*Link, the same errors in both directions*/
+	pckt_sim_get_config_defaults(&sim_conf);
+	sim_conf.rate          = 11520;
+	sim_conf.latency       = 5;
+	sim_conf.bit_err_ppm   = link->bit_err_ppm;
+	sim_conf.burst_ppm     = link->burst_ppm;
+	sim_conf.burst_len     = link->burst_len;
+	sim_conf.drop_ppm      = link->drop_ppm;
+	sim_conf.reorder_ppm   = link->reorder_ppm;
+	sim_conf.reorder_delay = link->reorder_delay;
+
+	sim_setup(sim_conf, (mode == SIM_MODE_DROP) ? PCKT_DISABLED : PCKT_ENABLED, (mode == SIM_MODE_REL) ? SIM_REL_WINDOW : 0, SIM_REL_TIMEOUT);
+
+	for(t = 0; t < (SIM_RUN + SIM_DRAIN); t++)
+	{
+		/*Send every frame made by now, reliable delivery holds them while the window is full*/
+		while((next_seq < SIM_FRAMES) && ((next_seq * SIM_INTERVAL) <= t))
+		{
+			pckt_sr_u32(&payload[0], next_seq);
+			pckt_sr_u32(&payload[4], next_seq * SIM_INTERVAL);
+
+			if(mode == SIM_MODE_REL)
+			{
+				if(pckt_rel_tx(&a_rel, SIM_DATA_ID, payload, sizeof(payload)) != 0) break;
+			}
+			else
+			{
+				pckt_tx_raw(&a_pckt_inst, SIM_DATA_ID, payload, sizeof(payload));
+			}
+
+			next_seq++;
+		}
+
+		sim_step((mode == SIM_MODE_REL) ? SIM_REL_WINDOW : 0);
+	}
+
+	printf("%-8s %-12s %7u %9u %7.2f %9.0f %6u %6u %6u %6u\n", mode_name[mode], link->name, SIM_FRAMES, delivered,
+		   100.0 * (SIM_FRAMES - delivered) / SIM_FRAMES, (double)delivered * SIM_PAYLOAD_LEN * 1000 / SIM_RUN,
+		   (unsigned)pckt_sim_lat_pct(&lat, 50), (unsigned)pckt_sim_lat_pct(&lat, 90), (unsigned)pckt_sim_lat_pct(&lat, 99), (unsigned)lat.max);
+}
+
+/******************************************************************************
+*  \brief Run reliable delivery with one window over a lossy link
+*
+*  \note loss_ppm is the chance of losing a packet, in both directions
+******************************************************************************/
+static void sim_sweep(const uint8_t window, const uint32_t loss_ppm)
+{
+	pckt_sim_conf_t sim_conf;
+	uint8_t payload[SIM_SWEEP_LEN];
+	uint32_t next_seq = 0;
+
+	memset(seen, 0, sizeof(seen));
+	delivered = 0;
+	pckt_sim_lat_reset(&lat);
+
+	pckt_sim_get_config_defaults(&sim_conf);
+	sim_conf.rate     = SIM_SWEEP_RATE;
+	sim_conf.latency  = SIM_SWEEP_LATENCY;
+	sim_conf.loss_ppm = loss_ppm;
+
+	sim_setup(sim_conf, PCKT_ENABLED, window, SIM_SWEEP_TIMEOUT);
+
+	while((delivered < SIM_SWEEP_PACKETS) && (sim.now < SIM_SWEEP_MAX))
+	{
+		/*As many as the window takes*/
+		while(next_seq < SIM_SWEEP_PACKETS)
+		{
+			pckt_sr_u32(&payload[0], next_seq);
+			pckt_sr_u32(&payload[4], sim.tick);
+
+			if(pckt_rel_tx(&a_rel, SIM_DATA_ID, payload, sizeof(payload)) != 0) break;
+
+			next_seq++;
+		}
+
+		sim_step(window);
+	}
+
+	printf("   %7.1f (%5u)", (double)delivered * 1000 / (double)sim.now, (unsigned)a_rel.retx_count);
+}
+
+/******************************************************************************
+*  \brief Set up link and instances
+*
+*  \note B to A uses the next seed, window 0 for no reliable delivery
+******************************************************************************/
+static void sim_setup(pckt_sim_conf_t sim_conf, const pckt_en_t resync, const uint8_t window, const TICK_TYPE timeout)
+{
+	pckt_conf_t pckt_conf;
+
+	pckt_sim_init(&sim);
+	pckt_sim_chan_init(&sim, PCKT_SIM_A_TO_B, sim_conf, ab_queue, SIM_QUEUE_LEN);
+	sim_conf.seed++;
+	pckt_sim_chan_init(&sim, PCKT_SIM_B_TO_A, sim_conf, ba_queue, SIM_QUEUE_LEN);
+
+	/*Instances*/
+	pckt_get_config_defaults(&pckt_conf);
+	pckt_conf.tick_ptr             = &sim.tick;
+	pckt_conf.clear_buffer_timeout = SIM_RX_TIMEOUT;
+	pckt_conf.err_rply             = PCKT_ERR_RPLY_DISABLED;
+	pckt_conf.resync               = resync;
+
+	pckt_conf.rx_buffer_size       = SIM_RX_BUF_LEN;
+
+	pckt_conf.tx_data_fprt  = a_tx_data;
+	pckt_conf.rx_block_fptr = a_rx_block;
+	pckt_conf.rx_buffer     = a_rx_buffer;
+	pckt_init(&a_pckt_inst, pckt_conf);
+
+	pckt_conf.tx_data_fprt  = b_tx_data;
+	pckt_conf.rx_block_fptr = b_rx_block;
+	pckt_conf.rx_buffer     = b_rx_buffer;
+	pckt_init(&b_pckt_inst, pckt_conf);
+
+	if(window > 0)
+	{
+		pckt_rel_init(&a_rel, a_rel_slots, window, a_rel_pool, SIM_PAYLOAD_LEN, a_handler);
+		pckt_rel_init(&b_rel, b_rel_slots, window, b_rel_pool, SIM_PAYLOAD_LEN, b_handler);
+		a_rel.timeout = timeout;
+		b_rel.timeout = timeout;
+		pckt_rel_attach(&a_pckt_inst, &a_rel);
+		pckt_rel_attach(&b_pckt_inst, &b_rel);
+	}
+}
+
+/******************************************************************************
+*  \brief One tick
+*
+*  \note parses what arrived, runs timeouts and retransmits, then moves the
+*        clock on
+******************************************************************************/
+static void sim_step(const uint8_t window)
+{
+	while(pckt_sim_avail(&sim, PCKT_SIM_A_TO_B) > 0)
+	{
+		pckt_task_view(&b_pckt_inst, b_handler);
+	}
+
+	while(pckt_sim_avail(&sim, PCKT_SIM_B_TO_A) > 0)
+	{
+		pckt_task_view(&a_pckt_inst, a_handler);
+	}
+
+	/*Timeouts*/
+	pckt_task_view(&a_pckt_inst, a_handler);
+	pckt_task_view(&b_pckt_inst, b_handler);
+
+	if(window > 0)
+	{
+		pckt_rel_task(&a_rel);
+		pckt_rel_task(&b_rel);
+	}
+
+	pckt_sim_advance(&sim, 1);
+}
+
+/******************************************************************************
+*  \brief Frame delivered to B
+*
+*  \note
+******************************************************************************/
+static void sim_deliver(const uint8_t * const payload, const uint16_t len)
+{
+	uint32_t seq;
+
+	if((len != SIM_PAYLOAD_LEN) && (len != SIM_SWEEP_LEN)) return;
+
+	seq = pckt_unsr_u32(&payload[0]);
+
+	/*Corrupted frame that passed the crc*/
+	if((seq >= SIM_FRAMES) || seen[seq]) return;
+
+	seen[seq] = 1;
+	delivered++;
+
+	pckt_sim_lat_add(&lat, sim.tick - pckt_unsr_u32(&payload[4]));
+}
+
+/******************************************************************************
+*  \brief Link ends
+*
+*  \note
+******************************************************************************/
+static void a_tx_data(const uint8_t * const data, uint8_t len)
+{
+	pckt_sim_write(&sim, PCKT_SIM_A_TO_B, data, len);
+}
+
+static uint16_t a_rx_block(uint8_t * const data, const uint16_t len)
+{
+	return pckt_sim_read(&sim, PCKT_SIM_B_TO_A, data, len);
+}
+
+static void b_tx_data(const uint8_t * const data, uint8_t len)
+{
+	pckt_sim_write(&sim, PCKT_SIM_B_TO_A, data, len);
+}
+
+static uint16_t b_rx_block(uint8_t * const data, const uint16_t len)
+{
+	return pckt_sim_read(&sim, PCKT_SIM_A_TO_B, data, len);
+}
+
+/******************************************************************************
+*  \brief Packet handlers
+*
+*  \note also the in order delivery of reliable packets, A only gets ACK/NACK
+*        which its reliable layer uses
+******************************************************************************/
+static void a_handler(pckt_inst_t * const pckt_inst, const pckt_view_t * const pckt_view)
+{
+	(void)pckt_inst;
+	(void)pckt_view;
+}
+
+static void b_handler(pckt_inst_t * const pckt_inst, const pckt_view_t * const pckt_view)
+{
+	(void)pckt_inst;
+
+	if(pckt_view->id == SIM_DATA_ID) sim_deliver(pckt_view->payload, pckt_view->len);
+}
+
+static void check_handler(pckt_inst_t * const pckt_inst, const pckt_view_t * const pckt_view)
+{
+	(void)pckt_inst;
+
+	if((pckt_view->id == SIM_CHECK_ID) && (pckt_view->len == 4)) check_rx++;
+}